@@ -0,0 +1,232 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/integer.hpp>
+#include <aurora/job_system.hpp>
+#include <aurora/pool_allocator.hpp>
+#include <aurora/radix_sort.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Aura;
+
+/**
+ * Aurora-Common-Bench measures the job system, the pool allocator and the radix sort.
+ *
+ * A human-readable table is printed to stderr and the results are written as JSON to stdout:
+ *
+ *   {
+ *     "compiler": "...",
+ *     "results": [
+ *       { "name": "...", "batch_size": 10000, "ns_per_op": 1.23, "ops_per_second": 8.1e8 },
+ *       ...
+ *     ]
+ *   }
+ *
+ * Pass a substring as the first argument to only run the benchmarks whose name contains it.
+ */
+
+struct Result {
+  std::string name;
+  size_t batch_size;
+  double ns_per_op;
+  double ops_per_second;
+};
+
+static volatile u32 g_sink;
+static char const* g_filter = nullptr;
+static std::vector<Result> g_results;
+
+/**
+ * Run a benchmark and record the average time per operation.
+ *
+ * @param name        name of the benchmark
+ * @param batch_size  number of operations performed by a single invocation of `function`
+ * @param function    the benchmarked code
+ */
+static void Run(char const* name, size_t batch_size, std::function<void()> const& function) {
+  using clock = std::chrono::steady_clock;
+
+  if (g_filter && !std::strstr(name, g_filter)) {
+    return;
+  }
+
+  // Warm up caches and find an iteration count that runs for roughly 0.25 seconds.
+  size_t iterations = 1;
+
+  while (true) {
+    auto t0 = clock::now();
+    for (size_t i = 0; i < iterations; i++) function();
+    auto elapsed = std::chrono::duration<double>(clock::now() - t0).count();
+
+    if (elapsed >= 0.25) {
+      auto ns_per_op = elapsed * 1e9 / (double)(iterations * batch_size);
+
+      g_results.push_back({name, batch_size, ns_per_op, 1e9 / ns_per_op});
+      std::fprintf(stderr, "%-40s %8zu %10.3f ns/op %12.3f Mop/s\n", name, batch_size, ns_per_op, 1e3 / ns_per_op);
+      break;
+    }
+
+    iterations *= 2;
+  }
+}
+
+static void WriteJSON() {
+#if defined(__clang__)
+  auto compiler = std::string{"clang "} + __clang_version__;
+#elif defined(__GNUC__)
+  auto compiler = std::string{"gcc "} + __VERSION__;
+#elif defined(_MSC_VER)
+  auto compiler = std::string{"msvc "} + std::to_string(_MSC_VER);
+#else
+  auto compiler = std::string{"unknown"};
+#endif
+
+  std::printf("{\n");
+  std::printf("  \"compiler\": \"%s\",\n", compiler.c_str());
+  std::printf("  \"results\": [\n");
+
+  for (size_t i = 0; i < g_results.size(); i++) {
+    auto& result = g_results[i];
+
+    std::printf(
+      "    { \"name\": \"%s\", \"batch_size\": %zu, \"ns_per_op\": %.4f, \"ops_per_second\": %.1f }%s\n",
+      result.name.c_str(),
+      result.batch_size,
+      result.ns_per_op,
+      result.ops_per_second,
+      i + 1 < g_results.size() ? "," : ""
+    );
+  }
+
+  std::printf("  ]\n");
+  std::printf("}\n");
+}
+
+static auto g_rng = std::mt19937{};
+
+/**
+ * Call a function for the thread counts from one up to the number of hardware threads, doubling the count each time.
+ * The number of hardware threads is always included.
+ */
+static void ForEachThreadCount(std::function<void(u32)> const& function) {
+  auto max_thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (u32 thread_count = 1; thread_count < max_thread_count; thread_count *= 2) {
+    function(thread_count);
+  }
+
+  function(max_thread_count);
+}
+
+static void BenchmarkJobs() {
+  constexpr size_t k_count = 1000000;
+  constexpr size_t k_job_count = 10000;
+
+  std::vector<float> values(k_count);
+
+  for (auto& value : values) value = std::uniform_real_distribution<float>{-1, 1}(g_rng);
+
+  ForEachThreadCount([&](u32 thread_count) {
+    auto job_system = JobSystem{thread_count - 1};
+    auto suffix = " (" + std::to_string(thread_count) + " threads)";
+
+    Run(("JobSystem::ParallelFor" + suffix).c_str(), k_count, [&]() {
+      job_system.ParallelFor(0, k_count, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) values[i] = std::sin(values[i]);
+      });
+      g_sink = (u32)values[0];
+    });
+
+    Run(("JobSystem::Schedule" + suffix).c_str(), k_job_count, [&]() {
+      auto counter = JobCounter{};
+
+      for (size_t i = 0; i < k_job_count; i++) {
+        job_system.Schedule([]() { g_sink = 0; }, &counter);
+      }
+      job_system.Wait(counter);
+    });
+  });
+}
+
+static void BenchmarkPoolAllocator() {
+  constexpr size_t k_count = 100000;
+
+  // Roughly the size of a GameObject.
+  struct Object {
+    u8 data[192];
+  };
+
+  std::vector<void*> objects(k_count);
+
+  // Release in random order, so that the free list ends up shuffled as it would after a scene has been edited.
+  std::vector<size_t> order(k_count);
+
+  for (size_t i = 0; i < k_count; i++) order[i] = i;
+  std::shuffle(order.begin(), order.end(), g_rng);
+
+  Run("operator new/delete (192 bytes)", k_count, [&]() {
+    for (auto& object : objects) object = ::operator new(sizeof(Object));
+    for (auto i : order) ::operator delete(objects[i]);
+  });
+
+  auto pool = PoolAllocator<Object>{};
+
+  Run("PoolAllocator (192 bytes)", k_count, [&]() {
+    for (auto& object : objects) object = pool.Allocate();
+    for (auto i : order) pool.Release(objects[i]);
+  });
+}
+
+static void BenchmarkSort() {
+  constexpr size_t k_count = 10000;
+
+  struct DrawKey {
+    u64 key;
+    u32 index;
+  };
+
+  // Keys shaped like the render queue keys: a few pipelines, more materials and geometries, and a depth.
+  std::vector<DrawKey> keys;
+
+  for (u32 i = 0; i < k_count; i++) {
+    auto key = (g_rng() % 40ull) << 48 | (g_rng() % 300ull) << 32 | (g_rng() % 2000ull) << 16 | (g_rng() & 0xFFFF);
+
+    keys.push_back({key, i});
+  }
+
+  std::vector<DrawKey> items;
+  std::vector<DrawKey> buffer;
+
+  Run("std::sort (64-bit keys)", k_count, [&]() {
+    items = keys;
+    std::sort(items.begin(), items.end(), [](DrawKey const& a, DrawKey const& b) { return a.key < b.key; });
+    g_sink = items[0].index;
+  });
+
+  Run("RadixSort (64-bit keys)", k_count, [&]() {
+    items = keys;
+    RadixSort(items, buffer, [](DrawKey const& draw_key) { return draw_key.key; });
+    g_sink = items[0].index;
+  });
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    g_filter = argv[1];
+  }
+
+  BenchmarkJobs();
+  BenchmarkPoolAllocator();
+  BenchmarkSort();
+
+  WriteJSON();
+  return 0;
+}
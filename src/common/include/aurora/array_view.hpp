@@ -4,6 +4,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <type_traits>
 #include <vector>
 
 namespace Aura {
@@ -19,9 +20,15 @@ struct ArrayView {
 
   ArrayView(std::vector<T>& vec) : data_(vec.data()), size_(vec.size()) {}
 
+  template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+  ArrayView(std::vector<std::remove_const_t<U>> const& vec) : data_(vec.data()), size_(vec.size()) {}
+
   template<size_t size>
   ArrayView(std::array<T, size>& array) : data_(array.data()), size_(size) {}
 
+  template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+  ArrayView(ArrayView<std::remove_const_t<U>> view) : data_(view.data()), size_(view.size()) {}
+
   constexpr auto cbegin() const -> const_iterator {
     return data();
   }
@@ -51,7 +58,7 @@ struct ArrayView {
   }
 
   constexpr bool empty() const {
-    return size() != 0;
+    return size() == 0;
   }
 
   constexpr auto operator[](size_t i) const -> T const& {
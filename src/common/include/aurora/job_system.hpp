@@ -0,0 +1,368 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/integer.hpp>
+#include <aurora/utility.hpp>
+#include <aurora/work_stealing_deque.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aura {
+
+struct JobSystem;
+
+namespace detail {
+
+struct Job;
+
+struct JobThreadContext {
+  JobSystem* system = nullptr;
+  u32 index = 0;
+};
+
+inline thread_local JobThreadContext g_job_thread_context;
+
+} // namespace Aura::detail
+
+/**
+ * Counts the jobs that were scheduled with it and have not completed yet.
+ * A counter can be waited on with {@link #JobSystem::Wait} or used as the dependency of other jobs.
+ * It must outlive all jobs that signal it.
+ */
+struct JobCounter final : NonCopyable, NonMovable {
+  JobCounter() {}
+
+  /**
+   * Check whether all jobs that signal this counter have completed.
+   */
+  bool Done() const {
+    return value.load(std::memory_order_acquire) == 0;
+  }
+
+private:
+  friend struct JobSystem;
+
+  std::atomic<u32> value = 0;
+
+  // Guards the transition to zero and the list of jobs that depend on this counter.
+  std::mutex mutex;
+  std::vector<detail::Job*> waiting_jobs;
+};
+
+namespace detail {
+
+struct Job {
+  std::function<void()> function;
+  JobCounter* counter;
+};
+
+} // namespace Aura::detail
+
+/**
+ * A work-stealing job scheduler.
+ *
+ * Each worker thread and the thread that created the job system own a lock-free deque.
+ * Jobs scheduled from these threads are pushed to the bottom of the deque of the scheduling thread,
+ * and idle threads steal jobs from the top of the other deques. Jobs scheduled from any other thread
+ * go through a shared queue that is guarded by a mutex.
+ *
+ * Threads that wait for a {@link #JobCounter} execute jobs instead of blocking, so the creating thread
+ * helps with the work that it waits for and jobs may themselves wait for nested jobs.
+ */
+struct JobSystem final : NonCopyable, NonMovable {
+  /**
+   * Create a job system and start its worker threads.
+   * The calling thread becomes the owner of one of the deques.
+   *
+   * @param worker_count the number of worker threads, which may be zero
+   */
+  explicit JobSystem(u32 worker_count = DefaultWorkerCount()) {
+    deques.resize(worker_count + 1);
+
+    for (auto& deque : deques) {
+      deque = std::make_unique<WorkStealingDeque<detail::Job>>();
+    }
+
+    detail::g_job_thread_context = {this, 0};
+
+    for (u32 i = 1; i <= worker_count; i++) {
+      workers.emplace_back([this, i]() { WorkerMain(i); });
+    }
+  }
+
+ ~JobSystem() {
+    {
+      std::lock_guard lock{sleep_mutex};
+      quit = true;
+    }
+    sleep_condition.notify_all();
+
+    for (auto& worker : workers) worker.join();
+
+    if (detail::g_job_thread_context.system == this) {
+      detail::g_job_thread_context = {};
+    }
+
+    // Jobs that were never waited on are discarded.
+    for (auto& deque : deques) {
+      while (auto job = deque->Pop()) delete job;
+    }
+    for (auto job : shared_queue) delete job;
+  }
+
+  /**
+   * Get the job system that is shared by all subsystems. It is created on first use, by the calling thread.
+   */
+  static auto Get() -> JobSystem& {
+    // Never destroyed, so that systems with static storage duration may use it during their destruction.
+    static auto job_system = new JobSystem{};
+
+    return *job_system;
+  }
+
+  /**
+   * Get the default number of worker threads, which is one less than the number of hardware threads,
+   * leaving a hardware thread for the thread that creates the job system.
+   */
+  static auto DefaultWorkerCount() -> u32 {
+    return std::max(std::thread::hardware_concurrency(), 1u) - 1u;
+  }
+
+  auto WorkerCount() const -> u32 {
+    return (u32)workers.size();
+  }
+
+  /**
+   * Schedule a job for execution.
+   *
+   * @param function   the function to execute
+   * @param counter    an optional counter that is incremented now and decremented once the job has completed
+   * @param dependency an optional counter that must reach zero before the job may start
+   */
+  void Schedule(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr) {
+    auto job = new detail::Job{std::move(function), counter};
+
+    if (counter) {
+      counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (dependency) {
+      std::lock_guard lock{dependency->mutex};
+
+      if (dependency->value.load(std::memory_order_acquire) != 0) {
+        dependency->waiting_jobs.push_back(job);
+        return;
+      }
+    }
+
+    Submit(job);
+  }
+
+  /**
+   * Execute jobs on the calling thread until all jobs that signal a counter have completed.
+   *
+   * @param counter the counter
+   */
+  void Wait(JobCounter& counter) {
+    while (!counter.Done()) {
+      if (auto job = FindJob()) {
+        Execute(job);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    // The last job may still be releasing the jobs that depend on the counter.
+    std::lock_guard lock{counter.mutex};
+  }
+
+  /**
+   * Split a range into batches and process them in parallel. The calling thread processes batches as well
+   * and only returns once all batches have been processed.
+   *
+   * @param begin      the first index of the range
+   * @param end        the index one past the last index of the range
+   * @param batch_size the maximum number of indices per batch
+   * @param function   the function that processes a batch, given the range [batch_begin, batch_end)
+   */
+  void ParallelFor(size_t begin, size_t end, size_t batch_size, std::function<void(size_t, size_t)> const& function) {
+    if (end <= begin) {
+      return;
+    }
+
+    auto batch_count = (end - begin + batch_size - 1) / batch_size;
+
+    if (batch_count == 1 || workers.empty()) {
+      for (auto batch_begin = begin; batch_begin < end; batch_begin += batch_size) {
+        function(batch_begin, std::min(batch_begin + batch_size, end));
+      }
+      return;
+    }
+
+    JobCounter counter;
+
+    for (size_t batch = 1; batch < batch_count; batch++) {
+      auto batch_begin = begin + batch * batch_size;
+      auto batch_end = std::min(batch_begin + batch_size, end);
+
+      Schedule([&function, batch_begin, batch_end]() { function(batch_begin, batch_end); }, &counter);
+    }
+
+    function(begin, std::min(begin + batch_size, end));
+
+    Wait(counter);
+  }
+
+private:
+  static constexpr u32 k_spin_count = 64;
+
+  bool IsOwnThread() const {
+    return detail::g_job_thread_context.system == this;
+  }
+
+  void Submit(detail::Job* job) {
+    queued_jobs.fetch_add(1);
+
+    if (IsOwnThread()) {
+      if (!deques[detail::g_job_thread_context.index]->Push(job)) {
+        // The deque is full, run the job right away instead.
+        queued_jobs.fetch_sub(1);
+        Execute(job);
+        return;
+      }
+    } else {
+      std::lock_guard lock{shared_queue_mutex};
+      shared_queue.push_back(job);
+      shared_queue_size.fetch_add(1, std::memory_order_release);
+    }
+
+    if (sleeping_workers.load() > 0) {
+      { std::lock_guard lock{sleep_mutex}; }
+      sleep_condition.notify_one();
+    }
+  }
+
+  auto FindJob() -> detail::Job* {
+    auto& context = detail::g_job_thread_context;
+    auto deque_count = (u32)deques.size();
+    detail::Job* job = nullptr;
+    u32 start = 0;
+
+    if (context.system == this) {
+      job = deques[context.index]->Pop();
+      start = context.index + 1;
+    }
+
+    for (u32 i = 0; !job && i < deque_count; i++) {
+      auto victim = (start + i) % deque_count;
+
+      if (context.system != this || victim != context.index) {
+        job = deques[victim]->Steal();
+      }
+    }
+
+    if (!job && shared_queue_size.load(std::memory_order_acquire) > 0) {
+      std::lock_guard lock{shared_queue_mutex};
+
+      if (!shared_queue.empty()) {
+        job = shared_queue.front();
+        shared_queue.pop_front();
+        shared_queue_size.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+
+    if (job) {
+      queued_jobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    return job;
+  }
+
+  void Execute(detail::Job* job) {
+    job->function();
+
+    if (job->counter) {
+      Signal(*job->counter);
+    }
+
+    delete job;
+  }
+
+  void Signal(JobCounter& counter) {
+    auto value = counter.value.load(std::memory_order_relaxed);
+
+    // Fast path: this is not the last job, so no dependent jobs have to be released.
+    while (value > 1) {
+      if (counter.value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel)) {
+        return;
+      }
+    }
+
+    std::vector<detail::Job*> ready_jobs;
+
+    {
+      std::lock_guard lock{counter.mutex};
+
+      if (counter.value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ready_jobs.swap(counter.waiting_jobs);
+      }
+    }
+
+    for (auto job : ready_jobs) Submit(job);
+  }
+
+  void WorkerMain(u32 index) {
+    detail::g_job_thread_context = {this, index};
+
+    while (true) {
+      detail::Job* job = nullptr;
+
+      for (u32 i = 0; !job && i < k_spin_count; i++) {
+        job = FindJob();
+
+        if (!job) {
+          std::this_thread::yield();
+        }
+      }
+
+      if (job) {
+        Execute(job);
+        continue;
+      }
+
+      std::unique_lock lock{sleep_mutex};
+
+      sleeping_workers.fetch_add(1);
+      sleep_condition.wait(lock, [this]() { return quit || queued_jobs.load() > 0; });
+      sleeping_workers.fetch_sub(1);
+
+      if (quit) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<WorkStealingDeque<detail::Job>>> deques;
+  std::vector<std::thread> workers;
+
+  std::mutex shared_queue_mutex;
+  std::deque<detail::Job*> shared_queue;
+  std::atomic<size_t> shared_queue_size = 0;
+
+  // Used to put idle workers to sleep, without taking a lock when no worker is sleeping.
+  std::atomic<s64> queued_jobs = 0;
+  std::atomic<u32> sleeping_workers = 0;
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_condition;
+  bool quit = false;
+};
+
+} // namespace Aura
@@ -0,0 +1,112 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/integer.hpp>
+#include <aurora/utility.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * A pool of fixed-size memory slots for objects of a single type.
+ * Slots are carved out of slabs that grow geometrically and are recycled through an intrusive free list,
+ * so allocating and releasing a slot is constant time and objects of the same type are packed closely together.
+ *
+ * Slabs are kept until the pool is destroyed, so that memory released by unloading a scene
+ * is reused by the next scene instead of being returned to (and fragmenting) the heap.
+ *
+ * The pool is not thread-safe.
+ *
+ * @tparam T the type of the objects
+ */
+template<typename T>
+struct PoolAllocator final : NonCopyable, NonMovable {
+  static constexpr size_t k_min_slab_size = 64;
+  static constexpr size_t k_max_slab_size = 4096;
+
+  PoolAllocator() = default;
+
+  /**
+   * Get the pool that is shared by all users of type T.
+   */
+  static auto Get() -> PoolAllocator& {
+    // Never destroyed, so that objects with static storage duration may safely be released.
+    static auto pool = new PoolAllocator{};
+
+    return *pool;
+  }
+
+  /**
+   * Allocate uninitialized memory for a single object.
+   *
+   * @return a pointer to the memory
+   */
+  auto Allocate() -> void* {
+    if (!free_list) {
+      AllocateSlab();
+    }
+
+    auto slot = free_list;
+
+    free_list = slot->next;
+    used++;
+    return slot->storage;
+  }
+
+  /**
+   * Return the memory of an object to the pool. The object must already have been destroyed.
+   *
+   * @param object a pointer that was returned by Allocate()
+   */
+  void Release(void* object) {
+    auto slot = reinterpret_cast<Slot*>(object);
+
+    slot->next = free_list;
+    free_list = slot;
+    used--;
+  }
+
+  /**
+   * Get the number of slots that are currently allocated.
+   */
+  auto Size() const -> size_t {
+    return used;
+  }
+
+  /**
+   * Get the total number of slots in all slabs.
+   */
+  auto Capacity() const -> size_t {
+    return slot_count;
+  }
+
+private:
+  union Slot {
+    Slot* next;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  void AllocateSlab() {
+    auto slab_size = std::clamp(slot_count, k_min_slab_size, k_max_slab_size);
+    auto slab = std::unique_ptr<Slot[]>{new Slot[slab_size]};
+
+    for (size_t i = 0; i < slab_size; i++) {
+      slab[i].next = i + 1 < slab_size ? &slab[i + 1] : free_list;
+    }
+
+    free_list = &slab[0];
+    slot_count += slab_size;
+    slabs.push_back(std::move(slab));
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> slabs;
+  Slot* free_list = nullptr;
+  size_t slot_count = 0;
+  size_t used = 0;
+};
+
+} // namespace Aura
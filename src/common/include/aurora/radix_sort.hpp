@@ -0,0 +1,81 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/integer.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * Sort items by a 64-bit key in ascending order using a least significant digit radix sort.
+ *
+ * The keys are processed in eight passes of eight bits each. The histograms of all passes are built
+ * in a single pass over the input and passes in which all keys share the same digit are skipped,
+ * so keys that only use their upper or lower bits are sorted in fewer passes.
+ * The sort is stable and runs in linear time, which beats comparison sorts from a few hundred items onwards.
+ *
+ * @tparam T      the type of the items, which should be cheap to copy
+ * @param  items  the items to sort
+ * @param  buffer scratch memory, which is resized to the number of items. Reuse it to avoid allocations.
+ * @param  key    a function that returns the u64 key of an item
+ */
+template<typename T, typename Key>
+void RadixSort(std::vector<T>& items, std::vector<T>& buffer, Key&& key) {
+  constexpr int k_digit_bits = 8;
+  constexpr int k_pass_count = 64 / k_digit_bits;
+  constexpr size_t k_bucket_count = 1 << k_digit_bits;
+
+  const size_t count = items.size();
+
+  if (count <= 1) {
+    return;
+  }
+
+  size_t histograms[k_pass_count][k_bucket_count] {};
+
+  for (auto& item : items) {
+    u64 item_key = key(item);
+
+    for (int pass = 0; pass < k_pass_count; pass++) {
+      histograms[pass][(item_key >> (pass * k_digit_bits)) & (k_bucket_count - 1)]++;
+    }
+  }
+
+  buffer.resize(count);
+
+  auto source = &items;
+  auto target = &buffer;
+
+  for (int pass = 0; pass < k_pass_count; pass++) {
+    auto& histogram = histograms[pass];
+    auto shift = pass * k_digit_bits;
+
+    // All keys fall into the same bucket, so this pass would not change the order.
+    if (histogram[(key((*source)[0]) >> shift) & (k_bucket_count - 1)] == count) {
+      continue;
+    }
+
+    size_t offsets[k_bucket_count];
+    size_t offset = 0;
+
+    for (size_t bucket = 0; bucket < k_bucket_count; bucket++) {
+      offsets[bucket] = offset;
+      offset += histogram[bucket];
+    }
+
+    for (auto& item : *source) {
+      (*target)[offsets[(key(item) >> shift) & (k_bucket_count - 1)]++] = item;
+    }
+
+    std::swap(source, target);
+  }
+
+  if (source != &items) {
+    items.swap(buffer);
+  }
+}
+
+} // namespace Aura
@@ -0,0 +1,56 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/array_view.hpp>
+#include <aurora/integer.hpp>
+#include <type_traits>
+
+namespace Aura {
+
+/**
+ * A non-owning view of `size` elements of type `T` that are `stride` bytes apart.
+ * This is useful for accessing a single attribute of interleaved vertex data.
+ */
+template<typename T>
+struct StridedArrayView {
+  using byte = std::conditional_t<std::is_const_v<T>, u8 const, u8>;
+
+  constexpr StridedArrayView() : data_(nullptr), size_(0), stride_(sizeof(T)) {}
+
+  constexpr StridedArrayView(T* data, size_t size, size_t stride = sizeof(T))
+      : data_((byte*)data), size_(size), stride_(stride) {}
+
+  StridedArrayView(ArrayView<T> view) : StridedArrayView(view.data(), view.size()) {}
+
+  template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+  StridedArrayView(StridedArrayView<std::remove_const_t<U>> view)
+      : StridedArrayView(view.data(), view.size(), view.stride()) {}
+
+  constexpr auto data() const -> T* {
+    return (T*)data_;
+  }
+
+  constexpr auto size() const -> size_t {
+    return size_;
+  }
+
+  constexpr auto stride() const -> size_t {
+    return stride_;
+  }
+
+  constexpr bool empty() const {
+    return size() == 0;
+  }
+
+  constexpr auto operator[](size_t i) const -> T& {
+    return *(T*)(data_ + i * stride_);
+  }
+
+private:
+  byte* data_;
+  size_t size_;
+  size_t stride_;
+};
+
+} // namespace Aura
@@ -3,9 +3,14 @@
 
 #pragma once
 
+#include <aurora/integer.hpp>
 #include <functional>
 #include <utility>
 
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
 namespace Aura {
 
 struct NonCopyable {
@@ -27,6 +32,17 @@ constexpr void static_no_match() {
   static_assert(flag);
 }
 
+/**
+ * Count the number of set bits in a 64-bit value.
+ */
+inline auto popcount(u64 value) -> u32 {
+#if defined(_MSC_VER)
+  return (u32)__popcnt64(value);
+#else
+  return (u32)__builtin_popcountll(value);
+#endif
+}
+
 struct pair_hash {
   template<typename T1, typename T2>
   auto operator()(std::pair<T1, T2> const& pair) const noexcept -> size_t {
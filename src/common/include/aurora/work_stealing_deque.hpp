@@ -0,0 +1,117 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/integer.hpp>
+#include <aurora/utility.hpp>
+#include <atomic>
+#include <memory>
+
+namespace Aura {
+
+/**
+ * A bounded lock-free Chase-Lev deque of pointers.
+ * The owning thread pushes and pops at the bottom, while any other thread may steal from the top.
+ *
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê, Pop, Cohen and Zappa Nardelli,
+ * using sequentially consistent operations in place of the fences.
+ *
+ * @tparam T        the type of the pointed-to elements
+ * @tparam capacity the maximum number of elements, which must be a power of two
+ */
+template<typename T, size_t capacity = 4096>
+struct WorkStealingDeque final : NonCopyable, NonMovable {
+  static_assert((capacity & (capacity - 1)) == 0, "WorkStealingDeque: capacity must be a power of two");
+
+  WorkStealingDeque() : buffer(std::make_unique<std::atomic<T*>[]>(capacity)) {}
+
+  /**
+   * Push an element to the bottom of the deque. May only be called by the owning thread.
+   *
+   * @param element the element
+   * @return false if the deque is full
+   */
+  bool Push(T* element) {
+    auto b = bottom.load(std::memory_order_relaxed);
+    auto t = top.load(std::memory_order_acquire);
+
+    if (b - t >= (s64)capacity) {
+      return false;
+    }
+
+    buffer[b & k_mask].store(element, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop the most recently pushed element from the bottom of the deque. May only be called by the owning thread.
+   *
+   * @return the element or nullptr if the deque is empty
+   */
+  auto Pop() -> T* {
+    // The store to bottom must be ordered before the load from top, which requires sequential consistency.
+    auto b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_seq_cst);
+    auto t = top.load(std::memory_order_seq_cst);
+
+    if (t > b) {
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    auto element = buffer[b & k_mask].load(std::memory_order_relaxed);
+
+    if (t == b) {
+      // This is the last element, race against concurrent steals for it.
+      if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        element = nullptr;
+      }
+      bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return element;
+  }
+
+  /**
+   * Steal the least recently pushed element from the top of the deque. May be called by any thread.
+   *
+   * @return the element or nullptr if the deque is empty or another thread won the race for the element
+   */
+  auto Steal() -> T* {
+    auto t = top.load(std::memory_order_seq_cst);
+    auto b = bottom.load(std::memory_order_seq_cst);
+
+    if (t >= b) {
+      return nullptr;
+    }
+
+    auto element = buffer[t & k_mask].load(std::memory_order_relaxed);
+
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+
+    return element;
+  }
+
+  /**
+   * Get an estimate of the number of elements in the deque.
+   */
+  auto Size() const -> size_t {
+    auto b = bottom.load(std::memory_order_relaxed);
+    auto t = top.load(std::memory_order_relaxed);
+
+    return b > t ? (size_t)(b - t) : 0;
+  }
+
+private:
+  static constexpr s64 k_mask = (s64)capacity - 1;
+
+  // Keep the indices on separate cache lines, since they are written by different threads.
+  alignas(64) std::atomic<s64> top = 0;
+  alignas(64) std::atomic<s64> bottom = 0;
+  std::unique_ptr<std::atomic<T*>[]> buffer;
+};
+
+} // namespace Aura
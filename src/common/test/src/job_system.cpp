@@ -0,0 +1,338 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/job_system.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+namespace Aura {
+
+// The capacity of the per-thread deques of the job system (the default capacity of WorkStealingDeque).
+static constexpr u32 k_deque_capacity = 4096;
+
+static void TestParallelFor(JobSystem& job_system) {
+  struct Range {
+    size_t begin;
+    size_t end;
+    size_t batch_size;
+  };
+
+  const Range ranges[] {
+    {0, 0, 1}, {5, 5, 3}, {10, 3, 4}, {0, 1, 1}, {0, 1000, 1}, {0, 1000, 7},
+    {3, 1003, 1000}, {3, 1003, 2000}, {17, 100000, 64}, {0, 100000, 100001}
+  };
+
+  for (auto const& range : ranges) {
+    auto size = std::max(range.begin, range.end);
+    auto hits = std::make_unique<std::atomic<u32>[]>(size);
+    std::atomic<u32> bad_batch_count = 0;
+
+    for (size_t i = 0; i < size; i++) hits[i] = 0;
+
+    job_system.ParallelFor(range.begin, range.end, range.batch_size, [&](size_t batch_begin, size_t batch_end) {
+      if (batch_begin >= batch_end || batch_end - batch_begin > range.batch_size ||
+          batch_begin < range.begin || batch_end > range.end) {
+        bad_batch_count++;
+        return;
+      }
+
+      for (size_t i = batch_begin; i < batch_end; i++) hits[i]++;
+    });
+
+    size_t wrong_count = 0;
+
+    for (size_t i = 0; i < size; i++) {
+      auto expected = (i >= range.begin && i < range.end) ? 1u : 0u;
+
+      if (hits[i].load() != expected) wrong_count++;
+    }
+
+    Check(bad_batch_count == 0, "ParallelFor({}, {}, {}) with {} worker(s): {} batch(es) out of range",
+      range.begin, range.end, range.batch_size, job_system.WorkerCount(), bad_batch_count.load());
+    Check(wrong_count == 0, "ParallelFor({}, {}, {}) with {} worker(s): {} index(es) not processed exactly once",
+      range.begin, range.end, range.batch_size, job_system.WorkerCount(), wrong_count);
+  }
+}
+
+static void TestDependencies(JobSystem& job_system) {
+  // A chain in which every job depends on the counter of the previous job must run strictly in order.
+  {
+    constexpr u32 length = 256;
+
+    auto counters = std::make_unique<JobCounter[]>(length);
+    std::atomic<u32> next = 0;
+    std::atomic<u32> out_of_order_count = 0;
+
+    for (u32 i = 0; i < length; i++) {
+      job_system.Schedule([&, i]() {
+        if (next.fetch_add(1) != i) out_of_order_count++;
+      }, &counters[i], i > 0 ? &counters[i - 1] : nullptr);
+    }
+
+    for (u32 i = length; i-- > 0;) job_system.Wait(counters[i]);
+
+    Check(next == length, "dependency chain with {} worker(s): {} of {} jobs ran", job_system.WorkerCount(), next.load(), length);
+    Check(out_of_order_count == 0, "dependency chain with {} worker(s): {} job(s) ran out of order",
+      job_system.WorkerCount(), out_of_order_count.load());
+  }
+
+  // Jobs that depend on a counter must not start before every job that signals the counter has completed.
+  {
+    constexpr u32 width = 64;
+
+    JobCounter producers;
+    JobCounter consumers;
+    std::atomic<u32> produced = 0;
+    std::atomic<u32> early_count = 0;
+
+    for (u32 i = 0; i < width; i++) {
+      job_system.Schedule([&]() { produced++; }, &producers);
+    }
+    for (u32 i = 0; i < width; i++) {
+      job_system.Schedule([&]() {
+        if (produced.load() != width) early_count++;
+      }, &consumers, &producers);
+    }
+
+    job_system.Wait(consumers);
+    job_system.Wait(producers);
+
+    Check(early_count == 0, "fan-in with {} worker(s): {} job(s) started before their dependency completed",
+      job_system.WorkerCount(), early_count.load());
+  }
+
+  // A dependency that never had any jobs scheduled with it does not hold the job back.
+  {
+    JobCounter unused;
+    JobCounter counter;
+    bool executed = false;
+
+    job_system.Schedule([&]() { executed = true; }, &counter, &unused);
+    job_system.Wait(counter);
+
+    Check(executed, "job with {} worker(s) that depends on an unused counter did not run", job_system.WorkerCount());
+  }
+}
+
+static void TestNestedWait(JobSystem& job_system) {
+  // Each job schedules children and waits for them, so that every thread ends up waiting inside of a job.
+  {
+    constexpr u32 fan_out = 4;
+    constexpr u32 depth = 5;
+
+    std::atomic<u32> leaf_count = 0;
+    std::function<void(u32)> spawn = [&](u32 level) {
+      if (level == 0) {
+        leaf_count++;
+        return;
+      }
+
+      JobCounter counter;
+
+      for (u32 i = 0; i < fan_out; i++) {
+        job_system.Schedule([&, level]() { spawn(level - 1); }, &counter);
+      }
+      job_system.Wait(counter);
+    };
+
+    JobCounter counter;
+
+    job_system.Schedule([&]() { spawn(depth); }, &counter);
+    job_system.Wait(counter);
+
+    u32 expected = 1;
+    for (u32 i = 0; i < depth; i++) expected *= fan_out;
+
+    Check(leaf_count == expected, "nested Wait with {} worker(s): {} of {} leaf jobs ran",
+      job_system.WorkerCount(), leaf_count.load(), expected);
+  }
+
+  // ParallelFor nested inside of ParallelFor.
+  {
+    constexpr size_t outer = 64;
+    constexpr size_t inner = 256;
+
+    std::atomic<size_t> sum = 0;
+
+    job_system.ParallelFor(0, outer, 1, [&](size_t, size_t) {
+      job_system.ParallelFor(0, inner, 16, [&](size_t begin, size_t end) { sum += end - begin; });
+    });
+
+    Check(sum == outer * inner, "nested ParallelFor with {} worker(s): processed {} of {} indices",
+      job_system.WorkerCount(), sum.load(), outer * inner);
+  }
+}
+
+static void TestForeignThreads(JobSystem& job_system) {
+  // Threads that do not belong to the job system schedule jobs, which schedule more jobs, and wait for them.
+  {
+    constexpr int thread_count = 2;
+    constexpr u32 job_count = 1000;
+
+    std::atomic<u32> executed = 0;
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < thread_count; i++) {
+      threads.emplace_back([&]() {
+        JobCounter counter;
+
+        for (u32 j = 0; j < job_count; j++) {
+          job_system.Schedule([&]() {
+            executed++;
+            job_system.Schedule([&]() { executed++; }, &counter);
+          }, &counter);
+        }
+
+        job_system.Wait(counter);
+      });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    Check(executed == 2 * thread_count * job_count, "foreign threads with {} worker(s): {} of {} jobs ran",
+      job_system.WorkerCount(), executed.load(), 2 * thread_count * job_count);
+  }
+
+  // Jobs from a foreign thread that depend on jobs from the creating thread, waited for by the creating thread.
+  {
+    constexpr u32 job_count = 100;
+
+    JobCounter first;
+    JobCounter second;
+    std::atomic<u32> first_done = 0;
+    std::atomic<u32> second_done = 0;
+    std::atomic<u32> early_count = 0;
+
+    for (u32 i = 0; i < job_count; i++) {
+      job_system.Schedule([&]() { first_done++; }, &first);
+    }
+
+    std::thread{[&]() {
+      for (u32 i = 0; i < job_count; i++) {
+        job_system.Schedule([&]() {
+          if (first_done.load() != job_count) early_count++;
+          second_done++;
+        }, &second, &first);
+      }
+    }}.join();
+
+    job_system.Wait(second);
+    job_system.Wait(first);
+
+    Check(second_done == job_count, "jobs from a foreign thread with {} worker(s): {} of {} jobs ran",
+      job_system.WorkerCount(), second_done.load(), job_count);
+    Check(early_count == 0, "jobs from a foreign thread with {} worker(s): {} job(s) started before their dependency completed",
+      job_system.WorkerCount(), early_count.load());
+  }
+}
+
+static void TestDequeOverflow(JobSystem& job_system) {
+  const auto owner_thread = std::this_thread::get_id();
+
+  // Scheduling more jobs than fit into the deque runs the excess jobs right away on the scheduling thread.
+  {
+    constexpr u32 job_count = 3 * k_deque_capacity;
+
+    JobCounter counter;
+    std::atomic<u32> executed = 0;
+    std::atomic<u32> inline_count = 0;
+    std::atomic<bool> scheduling = true;
+
+    for (u32 i = 0; i < job_count; i++) {
+      job_system.Schedule([&]() {
+        if (scheduling.load() && std::this_thread::get_id() == owner_thread) inline_count++;
+        executed++;
+      }, &counter);
+    }
+
+    scheduling = false;
+    job_system.Wait(counter);
+
+    Check(executed == job_count, "deque overflow with {} worker(s): {} of {} jobs ran",
+      job_system.WorkerCount(), executed.load(), job_count);
+
+    // Without workers nothing takes jobs from the deque, so exactly the jobs that did not fit run inline.
+    if (job_system.WorkerCount() == 0) {
+      Check(inline_count == job_count - k_deque_capacity, "deque overflow without workers: {} instead of {} jobs ran inline",
+        inline_count.load(), job_count - k_deque_capacity);
+    }
+  }
+
+  // The same from within a job, which may run on a worker thread.
+  {
+    constexpr u32 job_count = 2 * k_deque_capacity;
+
+    JobCounter counter;
+    std::atomic<u32> executed = 0;
+
+    job_system.Schedule([&]() {
+      JobCounter children;
+
+      for (u32 i = 0; i < job_count; i++) {
+        job_system.Schedule([&]() { executed++; }, &children);
+      }
+      job_system.Wait(children);
+    }, &counter);
+
+    job_system.Wait(counter);
+
+    Check(executed == job_count, "deque overflow in a job with {} worker(s): {} of {} jobs ran",
+      job_system.WorkerCount(), executed.load(), job_count);
+  }
+
+  // Releasing more dependent jobs than fit into the deque at once.
+  {
+    constexpr u32 job_count = 2 * k_deque_capacity;
+
+    JobCounter gate;
+    JobCounter counter;
+    std::atomic<bool> gate_done = false;
+    std::atomic<u32> executed = 0;
+    std::atomic<u32> early_count = 0;
+
+    job_system.Schedule([&]() { gate_done = true; }, &gate);
+
+    for (u32 i = 0; i < job_count; i++) {
+      job_system.Schedule([&]() {
+        if (!gate_done.load()) early_count++;
+        executed++;
+      }, &counter, &gate);
+    }
+
+    job_system.Wait(counter);
+    job_system.Wait(gate);
+
+    Check(executed == job_count, "deque overflow on release with {} worker(s): {} of {} jobs ran",
+      job_system.WorkerCount(), executed.load(), job_count);
+    Check(early_count == 0, "deque overflow on release with {} worker(s): {} job(s) started before their dependency completed",
+      job_system.WorkerCount(), early_count.load());
+  }
+}
+
+void TestJobSystem() {
+  constexpr int round_count = 3;
+
+  const auto max_worker_count = std::max(std::thread::hardware_concurrency(), 4u);
+
+  for (u32 worker_count = 0; worker_count <= max_worker_count; worker_count++) {
+    JobSystem job_system{worker_count};
+
+    Check(job_system.WorkerCount() == worker_count, "job system has {} instead of {} worker(s)", job_system.WorkerCount(), worker_count);
+
+    // Repeat, since most failures are races that do not show up in every run.
+    for (int round = 0; round < round_count; round++) {
+      TestParallelFor(job_system);
+      TestDependencies(job_system);
+      TestNestedWait(job_system);
+      TestForeignThreads(job_system);
+      TestDequeOverflow(job_system);
+    }
+  }
+}
+
+} // namespace Aura
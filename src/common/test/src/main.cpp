@@ -0,0 +1,20 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <fmt/format.h>
+
+#include "test.hpp"
+
+using namespace Aura;
+
+int main() {
+  TestWorkStealingDeque();
+  TestJobSystem();
+
+  if (g_failure_count != 0) {
+    fmt::print(stderr, "{} check(s) failed\n", g_failure_count.load());
+    return 1;
+  }
+
+  fmt::print(stderr, "all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,30 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <fmt/format.h>
+#include <atomic>
+
+namespace Aura {
+
+/**
+ * Minimal test harness: a failed check is reported and counted but does not stop the test,
+ * so that a single run reports every failure. Checks may be made from any thread.
+ */
+inline std::atomic<int> g_failure_count = 0;
+
+template<typename... Args>
+auto Check(bool condition, char const* format, Args&&... args) -> bool {
+  if (!condition) {
+    fmt::print(stderr, "FAIL: ");
+    fmt::print(stderr, format, std::forward<Args>(args)...);
+    fmt::print(stderr, "\n");
+    g_failure_count++;
+  }
+  return condition;
+}
+
+void TestJobSystem();
+void TestWorkStealingDeque();
+
+} // namespace Aura
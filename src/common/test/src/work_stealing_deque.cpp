@@ -0,0 +1,116 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/work_stealing_deque.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+namespace Aura {
+
+static void TestSingleThreaded() {
+  constexpr size_t capacity = 64;
+
+  WorkStealingDeque<int, capacity> deque;
+  int values[capacity + 1];
+
+  const auto index_of = [&](int* element) -> std::ptrdiff_t {
+    return element ? element - values : -1;
+  };
+
+  Check(deque.Pop() == nullptr, "deque: Pop() from an empty deque returned an element");
+  Check(deque.Steal() == nullptr, "deque: Steal() from an empty deque returned an element");
+
+  // Run several rounds, so that the indices wrap around the ring buffer.
+  for (int round = 0; round < 4; round++) {
+    for (size_t i = 0; i < capacity; i++) {
+      Check(deque.Push(&values[i]), "deque: Push() failed at size {} of {}", i, capacity);
+    }
+    Check(!deque.Push(&values[capacity]), "deque: Push() into a full deque succeeded");
+    Check(deque.Size() == capacity, "deque: Size() is {} instead of {}", deque.Size(), capacity);
+
+    // Pop() takes from the bottom (LIFO), Steal() from the top (FIFO).
+    for (size_t i = 0; i < capacity / 2; i++) {
+      auto element = deque.Pop();
+      Check(element == &values[capacity - 1 - i], "deque: Pop() returned element {} instead of {}", index_of(element), capacity - 1 - i);
+    }
+    for (size_t i = 0; i < capacity / 2; i++) {
+      auto element = deque.Steal();
+      Check(element == &values[i], "deque: Steal() returned element {} instead of {}", index_of(element), i);
+    }
+
+    Check(deque.Size() == 0, "deque: Size() of an empty deque is {}", deque.Size());
+    Check(deque.Pop() == nullptr, "deque: Pop() from an emptied deque returned an element");
+  }
+}
+
+/**
+ * The owner pushes and pops while several threads steal. A small capacity makes the deque run full
+ * and empty often, which exercises the races for the last element. Every element must be taken exactly once.
+ */
+static void TestConcurrentSteal() {
+  constexpr size_t capacity = 64;
+  constexpr size_t element_count = 200000;
+  constexpr int thief_count = 3;
+
+  WorkStealingDeque<size_t, capacity> deque;
+  auto values = std::make_unique<size_t[]>(element_count);
+  auto taken = std::make_unique<std::atomic<u32>[]>(element_count);
+  std::atomic<bool> done = false;
+
+  for (size_t i = 0; i < element_count; i++) {
+    values[i] = i;
+    taken[i] = 0;
+  }
+
+  const auto take = [&](size_t* element) {
+    taken[*element].fetch_add(1, std::memory_order_relaxed);
+  };
+
+  std::vector<std::thread> thieves;
+
+  for (int i = 0; i < thief_count; i++) {
+    thieves.emplace_back([&]() {
+      while (!done.load() || deque.Size() != 0) {
+        if (auto element = deque.Steal()) {
+          take(element);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (size_t i = 0; i < element_count; i++) {
+    while (!deque.Push(&values[i])) {
+      if (auto element = deque.Pop()) take(element);
+    }
+
+    if (i % 3 == 0) {
+      if (auto element = deque.Pop()) take(element);
+    }
+  }
+
+  while (auto element = deque.Pop()) take(element);
+
+  done = true;
+  for (auto& thief : thieves) thief.join();
+
+  size_t wrong_count = 0;
+
+  for (size_t i = 0; i < element_count; i++) {
+    if (taken[i].load() != 1) wrong_count++;
+  }
+
+  Check(wrong_count == 0, "deque: {} of {} elements were not taken exactly once", wrong_count, element_count);
+}
+
+void TestWorkStealingDeque() {
+  TestSingleThreaded();
+  TestConcurrentSteal();
+}
+
+} // namespace Aura
@@ -20,7 +20,8 @@ struct BindGroupLayout {
     // https://vulkan.lunarg.com/doc/view/latest/windows/apispec.html#VkDescriptorType
     enum class Type : u32 {
       ImageWithSampler = 1,
-      UniformBuffer = 6
+      UniformBuffer = 6,
+      UniformBufferDynamic = 8
     };
 
     // subset of VkShaderStageFlagBits:
@@ -50,14 +51,29 @@ constexpr auto operator|(
 }
 
 struct BindGroup {
+  static constexpr size_t k_whole_size = ~(size_t)0;
+
   virtual ~BindGroup() = default;
 
   virtual auto Handle() -> void* = 0;
 
+  /**
+   * Bind a range of a buffer to a binding.
+   * For {@link #BindGroupLayout::Entry::Type::UniformBufferDynamic} bindings, the offset that is passed to
+   * CommandBuffer::BindGraphicsBindGroup() is added to `offset` when the bind group is bound.
+   *
+   * @param binding the binding
+   * @param buffer  the buffer
+   * @param type    the type of the binding
+   * @param offset  the offset of the range in bytes
+   * @param size    the size of the range in bytes or k_whole_size for the rest of the buffer
+   */
   virtual void Bind(
     u32 binding,
     AnyPtr<Buffer> buffer,
-    BindGroupLayout::Entry::Type type
+    BindGroupLayout::Entry::Type type,
+    size_t offset = 0,
+    size_t size = k_whole_size
   ) = 0;
 
   virtual void Bind(
@@ -38,10 +38,36 @@ struct CommandBuffer {
 
   virtual void BindGraphicsPipeline(AnyPtr<GraphicsPipeline> pipeline) = 0;
 
+  /**
+   * Bind a bind group to a set.
+   *
+   * @param set             the set
+   * @param pipeline_layout the pipeline layout of the pipelines that will use the bind group
+   * @param bind_group      the bind group
+   * @param dynamic_offsets one offset for each dynamic buffer binding of the bind group, in binding order
+   */
   virtual void BindGraphicsBindGroup(
     u32 set,
     AnyPtr<PipelineLayout> pipeline_layout,
-    AnyPtr<BindGroup> bind_group
+    AnyPtr<BindGroup> bind_group,
+    ArrayView<u32 const> dynamic_offsets = {}
+  ) = 0;
+
+  /**
+   * Update a range of push constants.
+   *
+   * @param pipeline_layout the pipeline layout of the pipelines that will read the push constants
+   * @param stages          the shader stages of the push constant ranges that overlap the updated range
+   * @param offset          the offset of the range in bytes, which must be a multiple of four
+   * @param size            the size of the range in bytes, which must be a multiple of four
+   * @param data            the new values
+   */
+  virtual void PushConstants(
+    AnyPtr<PipelineLayout> pipeline_layout,
+    BindGroupLayout::Entry::ShaderStage stages,
+    u32 offset,
+    u32 size,
+    void const* data
   ) = 0;
 
   // TODO: find an efficient solution that supports std::unique_ptr.
@@ -1,11 +1,23 @@
-
 // Copyright (C) 2022 fleroviux. All rights reserved.
 
 #pragma once
 
+#include <aurora/gal/bind_group.hpp>
+#include <aurora/integer.hpp>
+
 namespace Aura {
 
 struct PipelineLayout {
+  /**
+   * A range of push constant memory that is accessed by a set of shader stages.
+   * Only 128 bytes of push constants are guaranteed to be available.
+   */
+  struct PushConstantRange {
+    BindGroupLayout::Entry::ShaderStage stages;
+    u32 offset;
+    u32 size;
+  };
+
   virtual ~PipelineLayout() = default;
 
   virtual auto Handle() -> void* = 0;
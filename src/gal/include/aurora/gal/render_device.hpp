@@ -36,6 +36,20 @@ struct RenderDevice {
     bool map = true
   ) -> std::unique_ptr<Buffer> = 0;
 
+  /**
+   * Create a buffer in host-visible memory that stays mapped for its whole lifetime.
+   * The host writes to it directly through Buffer::Data() and no copy commands are recorded,
+   * which suits data that is rewritten every frame. Call Buffer::Flush() after writing.
+   *
+   * @param usage the usage of the buffer
+   * @param size  the size of the buffer in bytes
+   * @return the buffer
+   */
+  virtual auto CreateMappedBuffer(
+    Buffer::Usage usage,
+    size_t size
+  ) -> std::unique_ptr<Buffer> = 0;
+
   template<typename T>
   auto CreateBufferWithData(
     Buffer::Usage usage,
@@ -120,7 +134,8 @@ struct RenderDevice {
   ) -> std::shared_ptr<BindGroupLayout> = 0;
 
   virtual auto CreatePipelineLayout(
-    std::vector<std::shared_ptr<BindGroupLayout>> const& bind_groups
+    std::vector<std::shared_ptr<BindGroupLayout>> const& bind_groups,
+    std::vector<PipelineLayout::PushConstantRange> const& push_constant_ranges = {}
   ) -> std::unique_ptr<PipelineLayout> = 0;
 
   virtual auto CreateGraphicsPipelineBuilder() -> std::unique_ptr<GraphicsPipelineBuilder> = 0;
@@ -135,6 +150,12 @@ struct RenderDevice {
 
   virtual auto GraphicsQueue() -> Queue* = 0;
 
+  /**
+   * Get the alignment in bytes that offsets into uniform buffers must have,
+   * including the dynamic offsets passed to CommandBuffer::BindGraphicsBindGroup().
+   */
+  virtual auto UniformBufferOffsetAlignment() const -> size_t = 0;
+
   // TODO: come up with a less hacky API for this.
   virtual void SetTransferCommandBuffer(CommandBuffer* cmd_buffer) = 0;
 };
@@ -0,0 +1,231 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/gal/command_buffer.hpp>
+#include <aurora/integer.hpp>
+#include <aurora/log.hpp>
+#include <algorithm>
+
+namespace Aura {
+
+/**
+ * Wraps a {@link #CommandBuffer} and drops pipeline, bind group, vertex buffer and index buffer binds
+ * that would bind the state that is already bound. All other commands are forwarded unchanged.
+ *
+ * The bound state is forgotten when recording or a render pass begins and whenever {@link #Invalidate} is called.
+ * Commands that are recorded through the wrapped command buffer or its handle bypass the cache,
+ * so call {@link #Invalidate} afterwards.
+ */
+struct StateCachingCommandBuffer final : CommandBuffer {
+  static constexpr u32 k_max_bind_groups = 8;
+  static constexpr size_t k_max_dynamic_offsets = 8;
+  static constexpr size_t k_max_vertex_buffers = 32;
+
+  StateCachingCommandBuffer(CommandBuffer& command_buffer) : command_buffer(command_buffer) {}
+
+  auto Handle() -> void* override {
+    return command_buffer.Handle();
+  }
+
+  void Begin(OneTimeSubmit one_time_submit) override {
+    command_buffer.Begin(one_time_submit);
+    Invalidate();
+  }
+
+  void End() override {
+    command_buffer.End();
+  }
+
+  void BeginRenderPass(
+    AnyPtr<RenderTarget> render_target,
+    AnyPtr<RenderPass> render_pass
+  ) override {
+    command_buffer.BeginRenderPass(render_target, render_pass);
+    Invalidate();
+  }
+
+  void EndRenderPass() override {
+    command_buffer.EndRenderPass();
+  }
+
+  void BindGraphicsPipeline(AnyPtr<GraphicsPipeline> pipeline) override {
+    if (pipeline.get() == bound_pipeline) {
+      elided_bind_count++;
+      return;
+    }
+
+    command_buffer.BindGraphicsPipeline(pipeline);
+    bound_pipeline = pipeline.get();
+    bind_count++;
+  }
+
+  void BindGraphicsBindGroup(
+    u32 set,
+    AnyPtr<PipelineLayout> pipeline_layout,
+    AnyPtr<BindGroup> bind_group,
+    ArrayView<u32 const> dynamic_offsets = {}
+  ) override {
+    if (set < k_max_bind_groups) {
+      auto& bound = bound_bind_groups[set];
+
+      const auto same_offsets = std::equal(
+        dynamic_offsets.cbegin(), dynamic_offsets.cend(),
+        bound.dynamic_offsets, bound.dynamic_offsets + bound.dynamic_offset_count
+      );
+
+      if (bound.pipeline_layout == pipeline_layout.get() && bound.bind_group == bind_group.get() && same_offsets) {
+        elided_bind_count++;
+        return;
+      }
+
+      // Binding with a different pipeline layout may disturb the other sets, so conservatively forget them.
+      for (auto& other : bound_bind_groups) {
+        if (other.pipeline_layout != pipeline_layout.get()) {
+          other = {};
+        }
+      }
+
+      // Bind groups with too many dynamic offsets are not cached and always bound.
+      if (dynamic_offsets.size() <= k_max_dynamic_offsets) {
+        bound = {pipeline_layout.get(), bind_group.get()};
+        std::copy(dynamic_offsets.cbegin(), dynamic_offsets.cend(), bound.dynamic_offsets);
+        bound.dynamic_offset_count = dynamic_offsets.size();
+      } else {
+        bound = {};
+      }
+    }
+
+    command_buffer.BindGraphicsBindGroup(set, pipeline_layout, bind_group, dynamic_offsets);
+    bind_count++;
+  }
+
+  void PushConstants(
+    AnyPtr<PipelineLayout> pipeline_layout,
+    BindGroupLayout::Entry::ShaderStage stages,
+    u32 offset,
+    u32 size,
+    void const* data
+  ) override {
+    command_buffer.PushConstants(pipeline_layout, stages, offset, size, data);
+  }
+
+  void BindVertexBuffers(
+    ArrayView<std::shared_ptr<Buffer>> buffers,
+    u32 first_binding = 0
+  ) override {
+    Assert(buffers.size() <= k_max_vertex_buffers,
+      "StateCachingCommandBuffer: can't bind more than 32 vertex buffers at once");
+
+    const auto same_buffers = std::equal(
+      buffers.begin(), buffers.end(),
+      bound_vertex_buffers, bound_vertex_buffers + bound_vertex_buffer_count,
+      [](std::shared_ptr<Buffer> const& a, Buffer* b) { return a.get() == b; }
+    );
+
+    if (same_buffers && first_binding == bound_first_binding) {
+      elided_bind_count++;
+      return;
+    }
+
+    command_buffer.BindVertexBuffers(buffers, first_binding);
+
+    for (size_t i = 0; i < buffers.size(); i++) bound_vertex_buffers[i] = buffers[i].get();
+    bound_vertex_buffer_count = buffers.size();
+    bound_first_binding = first_binding;
+    bind_count++;
+  }
+
+  void BindIndexBuffer(
+    AnyPtr<Buffer> buffer,
+    IndexDataType data_type,
+    size_t offset = 0
+  ) override {
+    if (buffer.get() == bound_index_buffer && data_type == bound_index_data_type && offset == bound_index_offset) {
+      elided_bind_count++;
+      return;
+    }
+
+    command_buffer.BindIndexBuffer(buffer, data_type, offset);
+    bound_index_buffer = buffer.get();
+    bound_index_data_type = data_type;
+    bound_index_offset = offset;
+    bind_count++;
+  }
+
+  void Draw(
+    u32 vertex_count,
+    u32 instance_count = 1,
+    u32 first_vertex = 0,
+    u32 first_instance = 0
+  ) override {
+    command_buffer.Draw(vertex_count, instance_count, first_vertex, first_instance);
+  }
+
+  void DrawIndexed(
+    u32 index_count,
+    u32 instance_count = 1,
+    u32 first_index = 0,
+    s32 vertex_offset = 0,
+    u32 first_instance = 0
+  ) override {
+    command_buffer.DrawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
+  }
+
+  void PipelineBarrier(
+    PipelineStage src_stage,
+    PipelineStage dst_stage,
+    ArrayView<MemoryBarrier> memory_barriers = {}
+  ) override {
+    command_buffer.PipelineBarrier(src_stage, dst_stage, memory_barriers);
+  }
+
+  /**
+   * Forget the bound state, so that the next bind of each kind is recorded.
+   */
+  void Invalidate() {
+    bound_pipeline = nullptr;
+    std::fill(std::begin(bound_bind_groups), std::end(bound_bind_groups), BoundBindGroup{});
+    bound_vertex_buffer_count = 0;
+    bound_first_binding = ~0u;
+    bound_index_buffer = nullptr;
+  }
+
+  /**
+   * Get the number of binds that were recorded.
+   */
+  auto GetBindCount() const -> u32 {
+    return bind_count;
+  }
+
+  /**
+   * Get the number of binds that were dropped because the state was already bound.
+   */
+  auto GetElidedBindCount() const -> u32 {
+    return elided_bind_count;
+  }
+
+private:
+  struct BoundBindGroup {
+    PipelineLayout* pipeline_layout = nullptr;
+    BindGroup* bind_group = nullptr;
+    u32 dynamic_offsets[k_max_dynamic_offsets]{};
+    size_t dynamic_offset_count = 0;
+  };
+
+  CommandBuffer& command_buffer;
+
+  GraphicsPipeline* bound_pipeline = nullptr;
+  BoundBindGroup bound_bind_groups[k_max_bind_groups];
+  Buffer* bound_vertex_buffers[k_max_vertex_buffers];
+  size_t bound_vertex_buffer_count = 0;
+  u32 bound_first_binding = ~0u;
+  Buffer* bound_index_buffer = nullptr;
+  IndexDataType bound_index_data_type;
+  size_t bound_index_offset = 0;
+
+  u32 bind_count = 0;
+  u32 elided_bind_count = 0;
+};
+
+} // namespace Aura
@@ -38,12 +38,14 @@ struct VulkanBindGroup final : BindGroup {
   void Bind(
     u32 binding,
     AnyPtr<Buffer> buffer,
-    BindGroupLayout::Entry::Type type
+    BindGroupLayout::Entry::Type type,
+    size_t offset = 0,
+    size_t size = k_whole_size
   ) override {
     auto buffer_info = VkDescriptorBufferInfo{
       .buffer = (VkBuffer)buffer->Handle(),
-      .offset = 0,
-      .range = VK_WHOLE_SIZE
+      .offset = offset,
+      .range = size == k_whole_size ? VK_WHOLE_SIZE : (VkDeviceSize)size
     };
 
     auto write_descriptor_set = VkWriteDescriptorSet{
@@ -43,7 +43,7 @@ struct VulkanBuffer final : Buffer {
       // TODO: evaluate if this is actually a good idea.
       buffer_info.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-      staging_buffer = std::make_unique<VulkanBuffer>(allocator, size);
+      staging_buffer = std::make_unique<VulkanBuffer>(allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size, VMA_MEMORY_USAGE_CPU_ONLY);
     }
 
     if (vmaCreateBuffer(allocator, &buffer_info, &alloc_info, &buffer, &allocation, nullptr) != VK_SUCCESS) {
@@ -55,24 +55,29 @@ struct VulkanBuffer final : Buffer {
     }
   }
 
-  // TODO: make it clear what kind of buffer is created
+  /**
+   * Create a buffer in host-visible memory, which is mapped directly instead of through a staging buffer.
+   * This is used for staging buffers (CPU_ONLY) and for buffers that the host rewrites every frame (CPU_TO_GPU).
+   */
   VulkanBuffer(
     VmaAllocator allocator,
-    size_t size
+    VkBufferUsageFlags usage,
+    size_t size,
+    VmaMemoryUsage memory_usage
   )   : allocator(allocator), size(size), host_visible(true) {
     auto buffer_info = VkBufferCreateInfo{
       .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
       .pNext = nullptr,
       .flags = 0,
       .size = size,
-      .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+      .usage = usage,
       .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
       .queueFamilyIndexCount = 0,
       .pQueueFamilyIndices = nullptr
     };
 
     auto alloc_info = VmaAllocationCreateInfo{
-      .usage = VMA_MEMORY_USAGE_CPU_ONLY
+      .usage = memory_usage
     };
 
     vmaCreateBuffer(allocator, &buffer_info, &alloc_info, &buffer, &allocation, nullptr);
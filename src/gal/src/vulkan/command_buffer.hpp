@@ -91,7 +91,8 @@ struct VulkanCommandBuffer final : CommandBuffer {
   void BindGraphicsBindGroup(
     u32 set,
     AnyPtr<PipelineLayout> pipeline_layout,
-    AnyPtr<BindGroup> bind_group
+    AnyPtr<BindGroup> bind_group,
+    ArrayView<u32 const> dynamic_offsets = {}
   ) override {
     auto vk_pipeline_layout = (VkPipelineLayout)pipeline_layout->Handle();
     auto vk_descriptor_set = (VkDescriptorSet)bind_group->Handle();
@@ -102,7 +103,24 @@ struct VulkanCommandBuffer final : CommandBuffer {
       vk_pipeline_layout,
       set,
       1, &vk_descriptor_set,
-      0, nullptr
+      (u32)dynamic_offsets.size(), dynamic_offsets.data()
+    );
+  }
+
+  void PushConstants(
+    AnyPtr<PipelineLayout> pipeline_layout,
+    BindGroupLayout::Entry::ShaderStage stages,
+    u32 offset,
+    u32 size,
+    void const* data
+  ) override {
+    vkCmdPushConstants(
+      buffer,
+      (VkPipelineLayout)pipeline_layout->Handle(),
+      (VkShaderStageFlags)stages,
+      offset,
+      size,
+      data
     );
   }
 
@@ -10,22 +10,32 @@ namespace Aura {
 struct VulkanPipelineLayout final : PipelineLayout {
   VulkanPipelineLayout(
     VkDevice device,
-    std::vector<std::shared_ptr<BindGroupLayout>> const& bind_groups
+    std::vector<std::shared_ptr<BindGroupLayout>> const& bind_groups,
+    std::vector<PushConstantRange> const& push_constant_ranges
   )   : device_(device), bind_groups_(bind_groups) {
     auto descriptor_set_layouts = std::vector<VkDescriptorSetLayout>{};
+    auto vk_push_constant_ranges = std::vector<VkPushConstantRange>{};
 
     for (auto& bind_group : bind_groups) {
       descriptor_set_layouts.push_back((VkDescriptorSetLayout)bind_group->Handle());
     }
 
+    for (auto& range : push_constant_ranges) {
+      vk_push_constant_ranges.push_back({
+        .stageFlags = (VkShaderStageFlags)range.stages,
+        .offset = range.offset,
+        .size = range.size
+      });
+    }
+
     auto info = VkPipelineLayoutCreateInfo{
       .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
       .pNext = nullptr,
       .flags = 0,
       .setLayoutCount = (u32)descriptor_set_layouts.size(),
       .pSetLayouts = descriptor_set_layouts.data(),
-      .pushConstantRangeCount = 0,
-      .pPushConstantRanges = nullptr
+      .pushConstantRangeCount = (u32)vk_push_constant_ranges.size(),
+      .pPushConstantRanges = vk_push_constant_ranges.data()
     };
 
     if (vkCreatePipelineLayout(device, &info, nullptr, &layout_) != VK_SUCCESS) {
@@ -27,6 +27,7 @@ struct VulkanRenderDevice final : RenderDevice {
       , physical_device(options.physical_device)
       , device(options.device)
       , queue_family_graphics(options.queue_family_graphics) {
+    vkGetPhysicalDeviceProperties(physical_device, &physical_device_properties);
     CreateVmaAllocator();
     CreateDescriptorPool();
     CreateQueues();
@@ -57,6 +58,16 @@ struct VulkanRenderDevice final : RenderDevice {
     );
   }
 
+  auto CreateMappedBuffer(
+    Buffer::Usage usage,
+    size_t size
+  ) -> std::unique_ptr<Buffer> override {
+    auto buffer = std::make_unique<VulkanBuffer>(allocator, (VkBufferUsageFlags)usage, size, VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+    buffer->Map();
+    return buffer;
+  }
+
   auto CreateShaderModule(
     u32 const* spirv,
     size_t size
@@ -141,9 +152,10 @@ struct VulkanRenderDevice final : RenderDevice {
   }
 
   auto CreatePipelineLayout(
-    std::vector<std::shared_ptr<BindGroupLayout>> const& bind_groups
+    std::vector<std::shared_ptr<BindGroupLayout>> const& bind_groups,
+    std::vector<PipelineLayout::PushConstantRange> const& push_constant_ranges = {}
   ) -> std::unique_ptr<PipelineLayout> override {
-    return std::make_unique<VulkanPipelineLayout>(device, bind_groups);
+    return std::make_unique<VulkanPipelineLayout>(device, bind_groups, push_constant_ranges);
   }
 
   auto CreateGraphicsPipelineBuilder() -> std::unique_ptr<GraphicsPipelineBuilder> override {
@@ -168,6 +180,10 @@ struct VulkanRenderDevice final : RenderDevice {
     return graphics_queue.get();
   }
 
+  auto UniformBufferOffsetAlignment() const -> size_t override {
+    return (size_t)physical_device_properties.limits.minUniformBufferOffsetAlignment;
+  }
+
   void SetTransferCommandBuffer(CommandBuffer* cmd_buffer) override {
     transfer_cmd_buffer = (VulkanCommandBuffer*)cmd_buffer;
   }
@@ -199,6 +215,10 @@ private:
         .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
         .descriptorCount = 4096
       },
+      {
+        .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+        .descriptorCount = 8192
+      },
       {
         .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
         .descriptorCount = 4096
@@ -227,6 +247,7 @@ private:
 
   VkInstance instance;
   VkPhysicalDevice physical_device;
+  VkPhysicalDeviceProperties physical_device_properties;
   VkDevice device;
   VkDescriptorPool descriptor_pool;
   VmaAllocator allocator;
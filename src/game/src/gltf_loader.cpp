@@ -151,6 +151,9 @@ void GLTFLoader::load_meshes(nlohmann::json const& gltf) {
         load_primitive_idx(primitive, geometry);
         load_primitive_vtx(primitive, geometry);
 
+        // Compute the bounds at load time rather than when the geometry is first culled.
+        geometry->compute_bounding_box();
+
         // TODO: material is not a required field - fallback to a standard material.
         mesh_out.primitives.push_back(Mesh::Primitive{
           .geometry = geometry,
@@ -529,10 +529,6 @@ struct Application {
 
 struct GlassMaterial final : Material {
   GlassMaterial() : Material(std::vector<std::string>{}) {
-    auto layout = UniformBlockLayout{};
-    layout.add<Matrix4>("model");
-    uniforms = UniformBlock{layout};
-
     blend_state.enable = true;
     blend_state.src_color_factor = BlendFactor::One;
     blend_state.src_alpha_factor = BlendFactor::Zero;
@@ -540,6 +536,7 @@ struct GlassMaterial final : Material {
     blend_state.dst_alpha_factor = BlendFactor::One;
 
     side() = Side::Both;
+    draw_data() = DrawData::ModelMatrix;
   }
 
   auto get_vert_shader() -> char const* override {
@@ -549,12 +546,12 @@ struct GlassMaterial final : Material {
   layout (location = 0) in vec3 a_position;
   layout (location = 1) in vec3 a_normal;
 
-  layout (binding = 0, std140) uniform Camera {
+  layout (set = 0, binding = 0, std140) uniform Camera {
     mat4 u_projection;
     mat4 u_view;
   };
 
-  layout (binding = 1, std140) uniform Material {
+  layout (push_constant) uniform Draw {
     mat4 u_model;
   };
 
@@ -587,12 +584,12 @@ struct GlassMaterial final : Material {
   layout(location = 1) in vec3 v_world_normal;
   layout(location = 2) in vec3 v_view_position;
 
-  layout (binding = 0, std140) uniform Camera {
+  layout (set = 0, binding = 0, std140) uniform Camera {
     mat4 u_projection;
     mat4 u_view;
   };
 
-  layout (binding = 34) uniform samplerCube u_env_map;
+  layout (set = 0, binding = 1) uniform samplerCube u_env_map;
 
   float FresnelSchlick(float f0, float n_dot_v) {
     return f0 + (1.0 - f0) * pow(1.0 - n_dot_v, 5.0);
@@ -622,6 +619,7 @@ struct GlassMaterial final : Material {
     return ArrayView<std::shared_ptr<Texture2D>>{nullptr, 0};
   }
 private:
+  // The glass shaders do not declare a material uniform block, so the block stays empty.
   UniformBlock uniforms;
 };
 
@@ -706,7 +704,7 @@ int main(int argc, char** argv) {
   scene->add_child(GLTFLoader{}.parse("Sponza/Sponza.gltf"));
 
   /*auto plane = GLTFLoader{}.parse("plane/plane.gltf");
-  plane->children()[0]->get_component<Mesh>()->material = std::make_shared<GlassMaterial>();
+  plane->children()[0]->get_component<Mesh>()->set_material(std::make_shared<GlassMaterial>());
   plane->transform().rotation().set_euler(M_PI * 0.5, 0.0, M_PI * 0.5);
   plane->transform().position() = Vector3{-4, 1, 0};
   scene->add_child(plane);*/
@@ -719,8 +717,8 @@ int main(int argc, char** argv) {
 
   //// test 1000 damaged helmets at once
   //auto helmet = GLTFLoader{}.parse("DamagedHelmet/DamagedHelmet.gltf")->children()[0];
-  //auto& geometry = helmet->get_component<Mesh>()->geometry;
-  //auto& material = helmet->get_component<Mesh>()->material;
+  //auto& geometry = helmet->get_component<Mesh>()->get_geometry();
+  //auto& material = helmet->get_component<Mesh>()->get_material();
   //for (int x = 0; x < 10; x++) {
   //  for (int y = 0; y < 10; y++) {
   //    for (int z = 0; z < 10; z++) {
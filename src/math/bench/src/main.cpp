@@ -0,0 +1,537 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/math/batch.hpp>
+#include <aurora/math/box3_array.hpp>
+#include <aurora/math/bvh.hpp>
+#include <aurora/math/frustum.hpp>
+#include <aurora/math/quantized.hpp>
+#include <aurora/math/quaternion.hpp>
+#include <aurora/math/quaternion_array.hpp>
+#include <aurora/integer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Aura;
+
+/**
+ * Aurora-Math-Bench measures the primitives that our scene sizes are tuned against.
+ *
+ * A human-readable table is printed to stderr and the results are written as JSON to stdout:
+ *
+ *   {
+ *     "compiler": "...",
+ *     "simd": "avx" | "sse" | "scalar",
+ *     "results": [
+ *       { "name": "...", "batch_size": 10000, "ns_per_op": 1.23, "ops_per_second": 8.1e8 },
+ *       ...
+ *     ]
+ *   }
+ *
+ * Pass a substring as the first argument to only run the benchmarks whose name contains it.
+ */
+
+struct Result {
+  std::string name;
+  size_t batch_size;
+  double ns_per_op;
+  double ops_per_second;
+};
+
+static volatile u32 g_sink;
+static char const* g_filter = nullptr;
+static std::vector<Result> g_results;
+
+/**
+ * Run a benchmark and record the average time per operation.
+ *
+ * @param name        name of the benchmark
+ * @param batch_size  number of operations performed by a single invocation of `function`
+ * @param function    the benchmarked code
+ */
+static void Run(char const* name, size_t batch_size, std::function<void()> const& function) {
+  using clock = std::chrono::steady_clock;
+
+  if (g_filter && !std::strstr(name, g_filter)) {
+    return;
+  }
+
+  // Warm up caches and find an iteration count that runs for roughly 0.25 seconds.
+  size_t iterations = 1;
+
+  while (true) {
+    auto t0 = clock::now();
+    for (size_t i = 0; i < iterations; i++) function();
+    auto elapsed = std::chrono::duration<double>(clock::now() - t0).count();
+
+    if (elapsed >= 0.25) {
+      auto ns_per_op = elapsed * 1e9 / (double)(iterations * batch_size);
+
+      g_results.push_back({name, batch_size, ns_per_op, 1e9 / ns_per_op});
+      std::fprintf(stderr, "%-40s %8zu %10.3f ns/op %12.3f Mop/s\n", name, batch_size, ns_per_op, 1e3 / ns_per_op);
+      break;
+    }
+
+    iterations *= 2;
+  }
+}
+
+static void WriteJSON() {
+#if defined(__clang__)
+  auto compiler = std::string{"clang "} + __clang_version__;
+#elif defined(__GNUC__)
+  auto compiler = std::string{"gcc "} + __VERSION__;
+#elif defined(_MSC_VER)
+  auto compiler = std::string{"msvc "} + std::to_string(_MSC_VER);
+#else
+  auto compiler = std::string{"unknown"};
+#endif
+
+#if defined(AURA_MATH_AVX)
+  auto simd = "avx";
+#elif defined(AURA_MATH_SSE)
+  auto simd = "sse";
+#else
+  auto simd = "scalar";
+#endif
+
+  std::printf("{\n");
+  std::printf("  \"compiler\": \"%s\",\n", compiler.c_str());
+  std::printf("  \"simd\": \"%s\",\n", simd);
+  std::printf("  \"results\": [\n");
+
+  for (size_t i = 0; i < g_results.size(); i++) {
+    auto& result = g_results[i];
+
+    std::printf(
+      "    { \"name\": \"%s\", \"batch_size\": %zu, \"ns_per_op\": %.4f, \"ops_per_second\": %.1f }%s\n",
+      result.name.c_str(),
+      result.batch_size,
+      result.ns_per_op,
+      result.ops_per_second,
+      i + 1 < g_results.size() ? "," : ""
+    );
+  }
+
+  std::printf("  ]\n");
+  std::printf("}\n");
+}
+
+static auto g_rng = std::mt19937{};
+
+static auto RandomFloat(float min = -1, float max = 1) -> float {
+  return std::uniform_real_distribution<float>{min, max}(g_rng);
+}
+
+static auto RandomVector3() -> Vector3 {
+  return Vector3{RandomFloat(), RandomFloat(), RandomFloat()};
+}
+
+static auto RandomVector4() -> Vector4 {
+  return Vector4{RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat()};
+}
+
+static auto RandomQuaternion() -> Quaternion {
+  auto quat = Quaternion{RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat()};
+  quat.Normalize();
+  return quat;
+}
+
+static auto RandomRigidMatrix() -> Matrix4 {
+  auto scale = RandomFloat(0.5, 2);
+
+  return Matrix4::Translation(RandomVector3() * 100) *
+         RandomQuaternion().ToRotationMatrix() *
+         Matrix4::Scale(scale, scale, scale);
+}
+
+static auto RandomAffineMatrix() -> Matrix4 {
+  return Matrix4::Translation(RandomVector3() * 100) *
+         RandomQuaternion().ToRotationMatrix() *
+         Matrix4::Scale(RandomFloat(0.5, 2), RandomFloat(0.5, 2), RandomFloat(0.5, 2));
+}
+
+static auto RandomBox3(float range, float size) -> Box3 {
+  auto center = RandomVector3() * range;
+  auto extent = Vector3{RandomFloat(0.1, size), RandomFloat(0.1, size), RandomFloat(0.1, size)};
+
+  Box3 box;
+  box.Min() = center - extent;
+  box.Max() = center + extent;
+  return box;
+}
+
+static auto CreateFrustum() -> Frustum {
+  auto projection = Matrix4::PerspectiveVK(1.0, 16 / 9.0, 0.01, 500.0);
+  auto view = Matrix4::Translation(0, 0, -250);
+
+  return Frustum::FromMatrix(projection * view);
+}
+
+static void BenchmarkVectors() {
+  constexpr size_t k_count = 10000;
+
+  std::vector<Vector3> a3(k_count);
+  std::vector<Vector3> b3(k_count);
+  std::vector<Vector3> c3(k_count);
+  std::vector<Vector4> a4(k_count);
+  std::vector<Vector4> b4(k_count);
+  std::vector<Vector4> c4(k_count);
+
+  for (size_t i = 0; i < k_count; i++) {
+    a3[i] = RandomVector3();
+    b3[i] = RandomVector3();
+    a4[i] = RandomVector4();
+    b4[i] = RandomVector4();
+  }
+
+  Run("Vector3::operator+", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) c3[i] = a3[i] + b3[i];
+    g_sink = (u32)c3[0].X();
+  });
+
+  Run("Vector3::Dot", k_count, [&]() {
+    float sum = 0;
+    for (size_t i = 0; i < k_count; i++) sum += a3[i].Dot(b3[i]);
+    g_sink = (u32)sum;
+  });
+
+  Run("Vector3::Cross", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) c3[i] = a3[i].Cross(b3[i]);
+    g_sink = (u32)c3[0].X();
+  });
+
+  Run("Vector3::Normalize", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) {
+      c3[i] = a3[i];
+      c3[i].Normalize();
+    }
+    g_sink = (u32)c3[0].X();
+  });
+
+  Run("Vector4::operator+", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) c4[i] = a4[i] + b4[i];
+    g_sink = (u32)c4[0].X();
+  });
+
+  Run("Vector4::operator*(float)", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) c4[i] = a4[i] * 0.5f;
+    g_sink = (u32)c4[0].X();
+  });
+
+  Run("Vector4::Dot", k_count, [&]() {
+    float sum = 0;
+    for (size_t i = 0; i < k_count; i++) sum += a4[i].Dot(b4[i]);
+    g_sink = (u32)sum;
+  });
+}
+
+static void BenchmarkMatrices() {
+  constexpr size_t k_count = 10000;
+
+  std::vector<Matrix4> rigid(k_count);
+  std::vector<Matrix4> affine(k_count);
+  std::vector<Matrix4> result(k_count);
+  std::vector<Vector4> vectors(k_count);
+  std::vector<Vector4> vectors_out(k_count);
+
+  for (size_t i = 0; i < k_count; i++) {
+    rigid[i] = RandomRigidMatrix();
+    affine[i] = RandomAffineMatrix();
+    vectors[i] = RandomVector4();
+  }
+
+  Run("Matrix4::operator*(Vector4)", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) vectors_out[i] = affine[i] * vectors[i];
+    g_sink = (u32)vectors_out[0].X();
+  });
+
+  Run("Matrix4::operator*(Matrix4)", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) result[i] = affine[i] * rigid[i];
+    g_sink = (u32)result[0][0][0];
+  });
+
+  Run("Matrix4::Inverse", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) result[i] = affine[i].Inverse();
+    g_sink = (u32)result[0][0][0];
+  });
+
+  Run("Matrix4::InverseAffine", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) result[i] = affine[i].InverseAffine();
+    g_sink = (u32)result[0][0][0];
+  });
+
+  Run("Matrix4::InverseRigid", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) result[i] = rigid[i].InverseRigid();
+    g_sink = (u32)result[0][0][0];
+  });
+}
+
+static void BenchmarkRotations() {
+  constexpr size_t k_count = 10000;
+
+  std::vector<Quaternion> quaternions(k_count);
+  std::vector<Quaternion> quaternions_out(k_count);
+  std::vector<Matrix4> matrices(k_count);
+  QuaternionArray quaternion_array_a;
+  QuaternionArray quaternion_array_b;
+  QuaternionArray quaternion_array_out;
+
+  for (size_t i = 0; i < k_count; i++) {
+    quaternions[i] = RandomQuaternion();
+    quaternion_array_a.Push(quaternions[i]);
+    quaternion_array_b.Push(RandomQuaternion());
+  }
+
+  Run("Quaternion::ToRotationMatrix", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) matrices[i] = quaternions[i].ToRotationMatrix();
+    g_sink = (u32)matrices[0][0][0];
+  });
+
+  Run("QuaternionsToRotationMatrices", k_count, [&]() {
+    QuaternionsToRotationMatrices(quaternion_array_a, matrices);
+    g_sink = (u32)matrices[0][0][0];
+  });
+
+  Run("Quaternion::operator*", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) {
+      quaternions_out[i] = quaternions[i] * quaternion_array_b.Get(i);
+    }
+    g_sink = (u32)quaternions_out[0].W();
+  });
+
+  Run("MultiplyQuaternions", k_count, [&]() {
+    MultiplyQuaternions(quaternion_array_a, quaternion_array_b, quaternion_array_out);
+    g_sink = (u32)quaternion_array_out.W()[0];
+  });
+
+  Run("Quaternion::NLerp", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) {
+      quaternions_out[i] = Quaternion::NLerp(quaternions[i], quaternion_array_b.Get(i), 0.3f);
+    }
+    g_sink = (u32)quaternions_out[0].W();
+  });
+
+  Run("NLerpQuaternions", k_count, [&]() {
+    NLerpQuaternions(quaternion_array_a, quaternion_array_b, 0.3f, quaternion_array_out);
+    g_sink = (u32)quaternion_array_out.W()[0];
+  });
+
+  Run("Quaternion::SLerp", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) {
+      quaternions_out[i] = Quaternion::SLerp(quaternions[i], quaternion_array_b.Get(i), 0.3f);
+    }
+    g_sink = (u32)quaternions_out[0].W();
+  });
+
+  Run("SLerpQuaternions", k_count, [&]() {
+    SLerpQuaternions(quaternion_array_a, quaternion_array_b, 0.3f, quaternion_array_out);
+    g_sink = (u32)quaternion_array_out.W()[0];
+  });
+}
+
+static void BenchmarkBounds() {
+  constexpr size_t k_count = 50000;
+
+  auto frustum = CreateFrustum();
+
+  std::vector<Box3> boxes;
+  std::vector<Box3> boxes_out(k_count);
+  std::vector<Matrix4> matrices;
+  std::vector<u8> visible_mask(k_count);
+  Box3Array box_array;
+
+  for (size_t i = 0; i < k_count; i++) {
+    auto box = RandomBox3(250, 5);
+
+    boxes.push_back(box);
+    box_array.Push(box);
+    matrices.push_back(RandomRigidMatrix());
+  }
+
+  Run("Box3::ApplyMatrix", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) boxes_out[i] = boxes[i].ApplyMatrix(matrices[i]);
+    g_sink = (u32)boxes_out[0].Min().X();
+  });
+
+  Run("Frustum::ContainsBox", k_count, [&]() {
+    u32 visible = 0;
+    for (auto& box : boxes) visible += frustum.ContainsBox(box) ? 1 : 0;
+    g_sink = visible;
+  });
+
+  Run("Frustum::CullBoxes (ArrayView<Box3>)", k_count, [&]() {
+    frustum.CullBoxes(boxes, visible_mask.data());
+    g_sink = visible_mask[0];
+  });
+
+  Run("Frustum::CullBoxes (Box3Array)", k_count, [&]() {
+    frustum.CullBoxes(box_array, visible_mask.data());
+    g_sink = visible_mask[0];
+  });
+}
+
+static void BenchmarkPointStreams() {
+  constexpr size_t k_count = 1000000;
+  constexpr size_t k_stride = 32; // position, normal and UV
+
+  std::vector<u8> vertices(k_count * k_stride);
+  auto points = StridedArrayView<Vector3>{(Vector3*)vertices.data(), k_count, k_stride};
+
+  for (size_t i = 0; i < k_count; i++) {
+    points[i] = RandomVector3() * 100;
+  }
+
+  Run("ComputeBoundingBox", k_count, [&]() {
+    g_sink = (u32)ComputeBoundingBox(points).Max().X();
+  });
+
+  Run("ComputeBoundingSphere", k_count, [&]() {
+    g_sink = (u32)ComputeBoundingSphere(points, Vector3{}).Radius();
+  });
+
+  Run("ComputeCentroid", k_count, [&]() {
+    g_sink = (u32)ComputeCentroid(points).X();
+  });
+
+  auto matrix = Matrix4::Translation(1, 2, 3) * Matrix4::RotationY(0.5f);
+
+  Run("TransformPoints", k_count, [&]() {
+    TransformPoints(matrix, points, points);
+    g_sink = (u32)points[0].X();
+  });
+}
+
+static void BenchmarkQuantization() {
+  constexpr size_t k_count = 1000000;
+
+  std::vector<Vector3> normals(k_count);
+  std::vector<Vector3h> normals_half(k_count);
+  std::vector<OctahedralNormal> normals_octahedral(k_count);
+
+  for (size_t i = 0; i < k_count; i++) {
+    normals[i] = RandomVector3().Normalize();
+  }
+
+  auto components = ArrayView<float>{normals[0].Data(), k_count * 3};
+  auto components_half = ArrayView<u16>{normals_half[0].Data(), k_count * 3};
+  auto normals_view = StridedArrayView<Vector3>{normals.data(), k_count};
+
+  Run("Vector3h::Vector3h", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) normals_half[i] = Vector3h{normals[i]};
+    g_sink = normals_half[0].X();
+  });
+
+  Run("PackHalf", k_count, [&]() {
+    PackHalf(components, components_half);
+    g_sink = normals_half[0].X();
+  });
+
+  Run("UnpackHalf", k_count, [&]() {
+    UnpackHalf(components_half, components);
+    g_sink = (u32)normals[0].X();
+  });
+
+  Run("OctahedralNormal::OctahedralNormal", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) normals_octahedral[i] = OctahedralNormal{normals[i]};
+    g_sink = normals_octahedral[0].X();
+  });
+
+  Run("PackOctahedral", k_count, [&]() {
+    PackOctahedral(normals_view, normals_octahedral);
+    g_sink = normals_octahedral[0].X();
+  });
+
+  Run("UnpackOctahedral", k_count, [&]() {
+    UnpackOctahedral(normals_octahedral, normals_view);
+    g_sink = (u32)normals[0].X();
+  });
+}
+
+static void BenchmarkBVH() {
+  constexpr size_t k_count = 100000;
+  constexpr size_t k_moved_count = 1000;
+
+  // A large scene of which only a small part is inside of the frustum.
+  auto frustum = CreateFrustum();
+
+  std::vector<Box3> boxes;
+  std::vector<u8> visible_mask(k_count);
+  Box3Array box_array;
+  BVH bvh;
+  std::vector<u32> proxies;
+
+  for (size_t i = 0; i < k_count; i++) {
+    auto box = RandomBox3(2500, 5);
+
+    boxes.push_back(box);
+    box_array.Push(box);
+    proxies.push_back(bvh.Insert(box, (u32)i));
+  }
+
+  bvh.Rebuild();
+
+  Run("Frustum::CullBoxes (linear)", k_count, [&]() {
+    frustum.CullBoxes(box_array, visible_mask.data());
+    g_sink = visible_mask[0];
+  });
+
+  Box3Array candidates;
+
+  Run("BVH::CullFrustum", k_count, [&]() {
+    u32 visible = 0;
+
+    candidates.Clear();
+
+    bvh.CullFrustum(frustum, [&](u32 item, bool inside) {
+      if (inside) {
+        visible++;
+      } else {
+        candidates.Push(boxes[item]);
+      }
+    });
+
+    frustum.CullBoxes(candidates, visible_mask.data());
+
+    for (size_t i = 0; i < candidates.Size(); i++) visible += visible_mask[i];
+    g_sink = visible;
+  });
+
+  Run("BVH::Update (1% of boxes moved)", k_moved_count, [&]() {
+    for (size_t i = 0; i < k_moved_count; i++) {
+      auto index = g_rng() % k_count;
+      auto offset = RandomVector3();
+      auto& box = boxes[index];
+
+      box = Box3{box.Min() + offset, box.Max() + offset};
+      bvh.Update(proxies[index], box);
+    }
+  });
+
+  Run("BVH::Rebuild", k_count, [&]() {
+    bvh.Rebuild();
+    g_sink = (u32)bvh.Cost();
+  });
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    g_filter = argv[1];
+  }
+
+  BenchmarkVectors();
+  BenchmarkMatrices();
+  BenchmarkRotations();
+  BenchmarkBounds();
+  BenchmarkPointStreams();
+  BenchmarkQuantization();
+  BenchmarkBVH();
+
+  WriteJSON();
+  return 0;
+}
@@ -0,0 +1,259 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <aurora/math/box3.hpp>
+#include <aurora/math/matrix4.hpp>
+#include <aurora/math/simd.hpp>
+#include <aurora/math/sphere.hpp>
+#include <aurora/strided_array_view.hpp>
+#include <cmath>
+#include <limits>
+
+/**
+ * Batch kernels that operate on strided streams of points, for example the position attribute of a vertex buffer.
+ *
+ * The SIMD code paths load four floats per point. The fourth float is only read for points that are
+ * followed by another point, so that the stream never is read out-of-bounds.
+ */
+
+namespace Aura {
+
+namespace detail {
+
+#if defined(AURA_MATH_SSE)
+
+inline auto LoadPoint(StridedArrayView<Aura::Vector3 const> points, size_t i) -> __m128 {
+  auto data = points[i].Data();
+
+  if (i + 1 < points.size()) {
+    return _mm_loadu_ps(data);
+  }
+  return _mm_setr_ps(data[0], data[1], data[2], 0);
+}
+
+inline void StorePoint(StridedArrayView<Aura::Vector3> points, size_t i, __m128 value) {
+  // Do not write the fourth lane, it may alias data of another attribute or point.
+  auto data = points[i].Data();
+
+  _mm_storel_pi((__m64*)data, value);
+  _mm_store_ss(&data[2], _mm_movehl_ps(value, value));
+}
+
+#endif
+
+} // namespace Aura::detail
+
+/**
+ * Transform a stream of points by an affine matrix.
+ * The input and output may be the same stream.
+ *
+ * @param matrix the (affine) matrix transform
+ * @param points_in  the input points
+ * @param points_out the output points, must hold at least as many points as `points_in`
+ */
+inline void TransformPoints(
+  Matrix4 const& matrix,
+  StridedArrayView<Vector3 const> points_in,
+  StridedArrayView<Vector3> points_out
+) {
+  const auto count = points_in.size();
+
+#if defined(AURA_MATH_SSE)
+  auto x = matrix.X().ToSSE();
+  auto y = matrix.Y().ToSSE();
+  auto z = matrix.Z().ToSSE();
+  auto w = matrix.W().ToSSE();
+
+  for (size_t i = 0; i < count; i++) {
+    auto point = detail::LoadPoint(points_in, i);
+
+    auto result = _mm_mul_ps(x, _mm_shuffle_ps(point, point, _MM_SHUFFLE(0, 0, 0, 0)));
+    result = _mm_add_ps(result, _mm_mul_ps(y, _mm_shuffle_ps(point, point, _MM_SHUFFLE(1, 1, 1, 1))));
+    result = _mm_add_ps(result, _mm_mul_ps(z, _mm_shuffle_ps(point, point, _MM_SHUFFLE(2, 2, 2, 2))));
+    result = _mm_add_ps(result, w);
+
+    detail::StorePoint(points_out, i, result);
+  }
+#else
+  auto x = matrix.X().XYZ();
+  auto y = matrix.Y().XYZ();
+  auto z = matrix.Z().XYZ();
+  auto w = matrix.W().XYZ();
+
+  for (size_t i = 0; i < count; i++) {
+    auto point = points_in[i];
+
+    points_out[i] = x * point.X() + y * point.Y() + z * point.Z() + w;
+  }
+#endif
+}
+
+/**
+ * Compute the axis-aligned bounding box of a stream of points.
+ * If the stream is empty, the minimum will be +infinity and the maximum -infinity.
+ *
+ * @param points the points
+ * @return the bounding box
+ */
+inline auto ComputeBoundingBox(StridedArrayView<Vector3 const> points) -> Box3 {
+  constexpr auto k_infinity = std::numeric_limits<float>::infinity();
+
+  const auto count = points.size();
+
+  Box3 box;
+
+#if defined(AURA_MATH_SSE)
+  // Use two sets of accumulators to break the dependency chain.
+  auto min0 = _mm_set1_ps(+k_infinity);
+  auto max0 = _mm_set1_ps(-k_infinity);
+  auto min1 = min0;
+  auto max1 = max0;
+
+  size_t i = 0;
+
+  for (; i + 2 <= count; i += 2) {
+    auto point0 = detail::LoadPoint(points, i + 0);
+    auto point1 = detail::LoadPoint(points, i + 1);
+
+    min0 = _mm_min_ps(min0, point0);
+    max0 = _mm_max_ps(max0, point0);
+    min1 = _mm_min_ps(min1, point1);
+    max1 = _mm_max_ps(max1, point1);
+  }
+
+  if (i < count) {
+    auto point = detail::LoadPoint(points, i);
+
+    min0 = _mm_min_ps(min0, point);
+    max0 = _mm_max_ps(max0, point);
+  }
+
+  float min[4];
+  float max[4];
+  _mm_storeu_ps(min, _mm_min_ps(min0, min1));
+  _mm_storeu_ps(max, _mm_max_ps(max0, max1));
+
+  box.Min() = Vector3{min[0], min[1], min[2]};
+  box.Max() = Vector3{max[0], max[1], max[2]};
+#else
+  box.Min() = Vector3{+k_infinity, +k_infinity, +k_infinity};
+  box.Max() = Vector3{-k_infinity, -k_infinity, -k_infinity};
+
+  for (size_t i = 0; i < count; i++) {
+    auto& point = points[i];
+
+    for (int j = 0; j < 3; j++) {
+      box.Min()[j] = std::min(box.Min()[j], point[j]);
+      box.Max()[j] = std::max(box.Max()[j], point[j]);
+    }
+  }
+#endif
+
+  return box;
+}
+
+/**
+ * Compute a bounding sphere with a given center point that encloses a stream of points.
+ *
+ * @param points the points
+ * @param center the center of the sphere
+ * @return the bounding sphere
+ */
+inline auto ComputeBoundingSphere(StridedArrayView<Vector3 const> points, Vector3 const& center) -> Sphere {
+  const auto count = points.size();
+
+  float radius2 = 0;
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  // Transpose groups of four points, so that four squared distances are computed at once.
+  auto center_sse = _mm_setr_ps(center.X(), center.Y(), center.Z(), 0);
+  auto radius2_sse = _mm_setzero_ps();
+
+  for (; i + 4 <= count; i += 4) {
+    auto d0 = _mm_sub_ps(detail::LoadPoint(points, i + 0), center_sse);
+    auto d1 = _mm_sub_ps(detail::LoadPoint(points, i + 1), center_sse);
+    auto d2 = _mm_sub_ps(detail::LoadPoint(points, i + 2), center_sse);
+    auto d3 = _mm_sub_ps(detail::LoadPoint(points, i + 3), center_sse);
+    _MM_TRANSPOSE4_PS(d0, d1, d2, d3);
+
+    auto distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d0, d0), _mm_mul_ps(d1, d1)), _mm_mul_ps(d2, d2));
+
+    radius2_sse = _mm_max_ps(radius2_sse, distance2);
+  }
+
+  float radius2_lanes[4];
+  _mm_storeu_ps(radius2_lanes, radius2_sse);
+  radius2 = std::max(std::max(radius2_lanes[0], radius2_lanes[1]), std::max(radius2_lanes[2], radius2_lanes[3]));
+#endif
+
+  for (; i < count; i++) {
+    auto distance = points[i] - center;
+
+    radius2 = std::max(radius2, distance.Dot(distance));
+  }
+
+  return Sphere{center, std::sqrt(radius2)};
+}
+
+/**
+ * Compute a bounding sphere that encloses a stream of points.
+ * The sphere is centered on the bounding box of the points, which is not necessarily the minimal sphere.
+ *
+ * @param points the points
+ * @return the bounding sphere
+ */
+inline auto ComputeBoundingSphere(StridedArrayView<Vector3 const> points) -> Sphere {
+  return ComputeBoundingSphere(points, ComputeBoundingBox(points).Center());
+}
+
+/**
+ * Compute the centroid (average) of a stream of points.
+ * Partial sums are accumulated in double precision, so that large streams do not lose precision.
+ *
+ * @param points the points
+ * @return the centroid or (0, 0, 0) if the stream is empty
+ */
+inline auto ComputeCentroid(StridedArrayView<Vector3 const> points) -> Vector3 {
+  constexpr size_t k_block_size = 1024;
+
+  const auto count = points.size();
+
+  if (count == 0) {
+    return Vector3{};
+  }
+
+  double sum[3] {0, 0, 0};
+
+  for (size_t base = 0; base < count; base += k_block_size) {
+    auto block_end = std::min(base + k_block_size, count);
+
+    float block_sum[4] {0, 0, 0, 0};
+
+#if defined(AURA_MATH_SSE)
+    auto block_sum_sse = _mm_setzero_ps();
+
+    for (size_t i = base; i < block_end; i++) {
+      block_sum_sse = _mm_add_ps(block_sum_sse, detail::LoadPoint(points, i));
+    }
+
+    _mm_storeu_ps(block_sum, block_sum_sse);
+#else
+    for (size_t i = base; i < block_end; i++) {
+      for (int j = 0; j < 3; j++) block_sum[j] += points[i][j];
+    }
+#endif
+
+    for (int j = 0; j < 3; j++) sum[j] += block_sum[j];
+  }
+
+  return Vector3{
+    (float)(sum[0] / (double)count),
+    (float)(sum[1] / (double)count),
+    (float)(sum[2] / (double)count)
+  };
+}
+
+} // namespace Aura
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <aurora/math/matrix4.hpp>
+#include <cmath>
 #include <limits>
 
 namespace Aura {
@@ -24,63 +25,138 @@ namespace Aura {
  *   v7 = (max.x, max.y, max.z)
  */
 struct Box3 {
+  /**
+   * Default constructor. Both the minimum and maximum are initialised to (0, 0, 0).
+   */
+  Box3() {}
+
+  /**
+   * Construct a Box3 from a minimum and a maximum vector.
+   *
+   * @param min the lower-left vertex
+   * @param max the upper-right vertex
+   */
+  Box3(Vector3 const& min, Vector3 const& max) : min(min), max(max) {}
+
+  /**
+   * Create an empty bounding box, which contains no point and is the identity for {@link #Union}.
+   * @return the empty bounding box
+   */
+  static auto Empty() -> Box3 {
+    constexpr auto k_infinity = std::numeric_limits<float>::infinity();
+
+    return Box3{
+      Vector3{+k_infinity, +k_infinity, +k_infinity},
+      Vector3{-k_infinity, -k_infinity, -k_infinity}
+    };
+  }
+
   auto Min() -> Vector3& { return min; }
   auto Max() -> Vector3& { return max; }
 
   auto Min() const -> Vector3 const& { return min; }
   auto Max() const -> Vector3 const& { return max; }
 
+  /**
+   * Check whether this bounding box is empty, i.e. its minimum is greater than its maximum on any axis.
+   * @return true if the bounding box is empty
+   */
+  bool IsEmpty() const {
+    return min.X() > max.X() || min.Y() > max.Y() || min.Z() > max.Z();
+  }
+
+  /**
+   * Calculate the smallest bounding box that contains both this and another bounding box.
+   *
+   * @param other the other bounding box
+   * @return the union of the two bounding boxes
+   */
+  auto Union(Box3 const& other) const -> Box3 {
+    Box3 box;
+
+    for (int i = 0; i < 3; i++) {
+      box.min[i] = std::min(min[i], other.min[i]);
+      box.max[i] = std::max(max[i], other.max[i]);
+    }
+    return box;
+  }
+
+  /**
+   * Calculate whether this bounding box and another bounding box overlap. Touching boxes are considered overlapping.
+   *
+   * @param other the other bounding box
+   * @return true if the bounding boxes overlap
+   */
+  bool IntersectsBox(Box3 const& other) const {
+    for (int i = 0; i < 3; i++) {
+      if (min[i] > other.max[i] || max[i] < other.min[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Get the center of this bounding box.
+   * @return the center point
+   */
+  auto Center() const -> Vector3 {
+    return (min + max) * 0.5f;
+  }
+
+  /**
+   * Get the extent of this bounding box, which is half of its size along each axis.
+   * @return the extent vector
+   */
+  auto Extent() const -> Vector3 {
+    return (max - min) * 0.5f;
+  }
+
+  /**
+   * Get the surface area of this bounding box, which is zero if the bounding box is empty.
+   * @return the surface area
+   */
+  auto SurfaceArea() const -> float {
+    if (IsEmpty()) {
+      return 0;
+    }
+
+    auto size = max - min;
+
+    return 2 * (size.X() * size.Y() + size.Y() * size.Z() + size.Z() * size.X());
+  }
+
   /**
    * Apply a matrix transform on each vertex of this bounding box.
    * Because the new bounding box must be axis-aligned new mininum and maximum
    * vectors will be computed to fit the transformed bounding box.
    *
+   * Rather than transforming all eight vertices, the center is transformed by the matrix
+   * and the extent by the absolute value of its upper 3x3 part.
+   *
    * @param matrix the matrix transform
    * @return the transformed bounding box
    */
   auto ApplyMatrix(Matrix4 const& matrix) const -> Box3 {
     Box3 box;
 
-    auto min_x = matrix.X().XYZ() * min.X();
-    auto max_x = matrix.X().XYZ() * max.X();
-    auto min_y = matrix.Y().XYZ() * min.Y();
-    auto max_y = matrix.Y().XYZ() * max.Y();
-    auto min_z = matrix.Z().XYZ() * min.Z();
-    auto max_z = matrix.Z().XYZ() * max.Z();
-    auto translation = matrix.W().XYZ();
-
-    Vector3 v[8];
-    v[0] = min_x + min_y + min_z + translation;
-    v[1] = max_x + min_y + min_z + translation;
-    v[2] = min_x + max_y + min_z + translation;
-    v[3] = max_x + max_y + min_z + translation;
-    v[4] = min_x + min_y + max_z + translation;
-    v[5] = max_x + min_y + max_z + translation;
-    v[6] = min_x + max_y + max_z + translation;
-    v[7] = max_x + max_y + max_z + translation;
-
-    box.min = Vector3{
-      +std::numeric_limits<float>::infinity(),
-      +std::numeric_limits<float>::infinity(),
-      +std::numeric_limits<float>::infinity()
-    };
+    auto center = Center();
+    auto extent = Extent();
 
-    box.max = Vector3{
-      -std::numeric_limits<float>::infinity(),
-      -std::numeric_limits<float>::infinity(),
-      -std::numeric_limits<float>::infinity()
-    };
+    auto new_center = matrix.X().XYZ() * center.X() +
+                      matrix.Y().XYZ() * center.Y() +
+                      matrix.Z().XYZ() * center.Z() + matrix.W().XYZ();
 
-    for (int i = 0; i < 8; i++) {
-      box.min.X() = std::min(box.min.X(), v[i].X());
-      box.min.Y() = std::min(box.min.Y(), v[i].Y());
-      box.min.Z() = std::min(box.min.Z(), v[i].Z());
+    auto new_extent = Vector3{};
 
-      box.max.X() = std::max(box.max.X(), v[i].X());
-      box.max.Y() = std::max(box.max.Y(), v[i].Y());
-      box.max.Z() = std::max(box.max.Z(), v[i].Z());
+    for (int i = 0; i < 3; i++) {
+      new_extent[i] = std::abs(matrix[0][i]) * extent.X() +
+                      std::abs(matrix[1][i]) * extent.Y() +
+                      std::abs(matrix[2][i]) * extent.Z();
     }
 
+    box.min = new_center - new_extent;
+    box.max = new_center + new_extent;
     return box;
   }
 
@@ -0,0 +1,103 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/box3.hpp>
+#include <aurora/integer.hpp>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * A list of axis-aligned bounding boxes stored in center-extent form as a structure of arrays.
+ * Each of the six components (center x, y, z and extent x, y, z) is stored in its own contiguous array,
+ * which allows SIMD kernels (i.e. {@link #Frustum::CullBoxes}) to process multiple boxes at once.
+ */
+struct Box3Array {
+  /**
+   * Get the number of bounding boxes in this array.
+   * @return the number of bounding boxes
+   */
+  auto Size() const -> size_t {
+    return center_x.size();
+  }
+
+  /**
+   * Reserve memory for a number of bounding boxes.
+   *
+   * @param capacity the number of bounding boxes
+   */
+  void Reserve(size_t capacity) {
+    center_x.reserve(capacity);
+    center_y.reserve(capacity);
+    center_z.reserve(capacity);
+    extent_x.reserve(capacity);
+    extent_y.reserve(capacity);
+    extent_z.reserve(capacity);
+  }
+
+  /**
+   * Remove all bounding boxes from this array.
+   */
+  void Clear() {
+    center_x.clear();
+    center_y.clear();
+    center_z.clear();
+    extent_x.clear();
+    extent_y.clear();
+    extent_z.clear();
+  }
+
+  /**
+   * Append a bounding box to the end of this array.
+   *
+   * @param box the bounding box
+   */
+  void Push(Box3 const& box) {
+    auto center = box.Center();
+    auto extent = box.Extent();
+
+    center_x.push_back(center.X());
+    center_y.push_back(center.Y());
+    center_z.push_back(center.Z());
+    extent_x.push_back(extent.X());
+    extent_y.push_back(extent.Y());
+    extent_z.push_back(extent.Z());
+  }
+
+  /**
+   * Replace the bounding box at an index.
+   * Out-of-bounds access is undefined behaviour.
+   *
+   * @param i   the index
+   * @param box the bounding box
+   */
+  void Set(size_t i, Box3 const& box) {
+    auto center = box.Center();
+    auto extent = box.Extent();
+
+    center_x[i] = center.X();
+    center_y[i] = center.Y();
+    center_z[i] = center.Z();
+    extent_x[i] = extent.X();
+    extent_y[i] = extent.Y();
+    extent_z[i] = extent.Z();
+  }
+
+  auto CenterX() const -> float const* { return center_x.data(); }
+  auto CenterY() const -> float const* { return center_y.data(); }
+  auto CenterZ() const -> float const* { return center_z.data(); }
+  auto ExtentX() const -> float const* { return extent_x.data(); }
+  auto ExtentY() const -> float const* { return extent_y.data(); }
+  auto ExtentZ() const -> float const* { return extent_z.data(); }
+
+private:
+  std::vector<float> center_x;
+  std::vector<float> center_y;
+  std::vector<float> center_z;
+  std::vector<float> extent_x;
+  std::vector<float> extent_y;
+  std::vector<float> extent_z;
+};
+
+} // namespace Aura
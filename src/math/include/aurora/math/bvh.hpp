@@ -0,0 +1,551 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/box3.hpp>
+#include <aurora/math/frustum.hpp>
+#include <aurora/array_view.hpp>
+#include <aurora/integer.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * A bounding volume hierarchy over axis-aligned bounding boxes, with a single item per leaf.
+ *
+ * The hierarchy can be built top-down using the surface area heuristic (SAH) with {@link #Rebuild},
+ * which gives the best quality for static content. Items can also be inserted, removed and moved incrementally:
+ * insertion picks the sibling that increases the surface area the least and moving an item only refits
+ * its ancestors. Incremental updates gradually degrade the quality of the hierarchy, which can be detected
+ * by comparing {@link #Cost} against the cost after the last rebuild.
+ *
+ * Leaves are identified by proxies, which remain valid until the leaf is removed, even across rebuilds.
+ */
+struct BVH {
+  static constexpr u32 k_null = ~0u;
+
+  /**
+   * Insert an item into the hierarchy.
+   *
+   * @param box  the bounding box of the item
+   * @param item a user-defined value that is passed to query callbacks
+   * @return the proxy of the new leaf
+   */
+  auto Insert(Box3 const& box, u32 item) -> u32 {
+    auto leaf = AllocateNode();
+
+    nodes[leaf].box = box;
+    nodes[leaf].item = item;
+    InsertLeaf(leaf);
+    return leaf;
+  }
+
+  /**
+   * Remove an item from the hierarchy.
+   *
+   * @param proxy the proxy returned by {@link #Insert}
+   */
+  void Remove(u32 proxy) {
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+  }
+
+  /**
+   * Change the bounding box of an item and refit the bounding boxes of its ancestors.
+   *
+   * @param proxy the proxy returned by {@link #Insert}
+   * @param box   the new bounding box of the item
+   */
+  void Update(u32 proxy, Box3 const& box) {
+    nodes[proxy].box = box;
+    Refit(nodes[proxy].parent);
+  }
+
+  /**
+   * Remove all items.
+   */
+  void Clear() {
+    nodes.clear();
+    free_node = k_null;
+    root = k_null;
+    internal_area = 0;
+  }
+
+  /**
+   * Replace all items by a list of bounding boxes and build the hierarchy using the binned surface area heuristic.
+   * This is much faster than inserting the boxes one by one.
+   * The proxy of each leaf is the index of its box.
+   *
+   * @param boxes the bounding boxes
+   * @param items the item of each box or an empty view to use the index of each box as its item
+   */
+  void Build(ArrayView<Box3 const> boxes, ArrayView<u32 const> items = {}) {
+    std::vector<BuildLeaf> leaves;
+
+    Clear();
+    nodes.reserve(boxes.size() * 2);
+    nodes.resize(boxes.size());
+    leaves.reserve(boxes.size());
+
+    for (u32 index = 0; index < (u32)boxes.size(); index++) {
+      auto& node = nodes[index];
+
+      node.box = boxes[index];
+      node.item = items.empty() ? index : items[index];
+      node.allocated = true;
+      leaves.push_back({node.box, node.box.Center(), index});
+    }
+
+    root = leaves.empty() ? k_null : BuildSubtree(leaves, 0, leaves.size());
+
+    if (root != k_null) {
+      nodes[root].parent = k_null;
+    }
+  }
+
+  /**
+   * Rebuild the internal nodes of the hierarchy over the existing leaves using the binned surface area heuristic.
+   * Proxies remain valid.
+   */
+  void Rebuild() {
+    std::vector<BuildLeaf> leaves;
+
+    for (u32 index = 0; index < (u32)nodes.size(); index++) {
+      auto& node = nodes[index];
+
+      if (node.allocated && node.IsLeaf()) {
+        leaves.push_back({node.box, node.box.Center(), index});
+      } else if (node.allocated) {
+        FreeNode(index);
+      }
+    }
+
+    internal_area = 0;
+    root = leaves.empty() ? k_null : BuildSubtree(leaves, 0, leaves.size());
+
+    if (root != k_null) {
+      nodes[root].parent = k_null;
+    }
+  }
+
+  /**
+   * Get the SAH cost of the hierarchy, which is the summed surface area of the internal nodes
+   * relative to the surface area of the root. Lower is better.
+   *
+   * @return the cost
+   */
+  auto Cost() const -> float {
+    if (root == k_null || nodes[root].IsLeaf()) {
+      return 0;
+    }
+
+    auto root_area = nodes[root].box.SurfaceArea();
+
+    return root_area > 0 ? internal_area / root_area : 0;
+  }
+
+  auto GetBox(u32 proxy) const -> Box3 const& {
+    return nodes[proxy].box;
+  }
+
+  auto GetItem(u32 proxy) const -> u32 {
+    return nodes[proxy].item;
+  }
+
+  /**
+   * Get the bounding box of all items.
+   */
+  auto GetBounds() const -> Box3 {
+    return root == k_null ? Box3::Empty() : nodes[root].box;
+  }
+
+  /**
+   * Visit the items that may be inside a frustum.
+   * Subtrees outside of the frustum are skipped and subtrees fully inside of the frustum are visited without further tests.
+   * The leaves of intersecting subtrees are not tested individually, so that the caller can test them in batches,
+   * for example with {@link #Frustum::CullBoxes}.
+   *
+   * @param frustum the frustum
+   * @param visit   a function that is called with the item and whether it is known to be fully inside of the frustum
+   */
+  template<typename Visit>
+  void CullFrustum(Frustum const& frustum, Visit&& visit) const {
+    if (root == k_null) {
+      return;
+    }
+
+    std::vector<u32> stack{root};
+
+    while (!stack.empty()) {
+      auto& node = nodes[stack.back()];
+
+      stack.pop_back();
+
+      if (node.IsLeaf()) {
+        visit(node.item, false);
+        continue;
+      }
+
+      switch (frustum.ClassifyBox(node.box)) {
+        case Frustum::Containment::Outside:
+          break;
+        case Frustum::Containment::Intersecting:
+          stack.push_back(node.children[0]);
+          stack.push_back(node.children[1]);
+          break;
+        case Frustum::Containment::Inside:
+          VisitSubtree(node, [&](u32 item) { visit(item, true); });
+          break;
+      }
+    }
+  }
+
+  /**
+   * Visit the items whose bounding box passes a test. Subtrees whose bounding box fails the test are skipped.
+   *
+   * @param test  a function that is called with a bounding box and returns whether it may contain matching items
+   * @param visit a function that is called with the proxy of each leaf that passed the test
+   */
+  template<typename Test, typename Visit>
+  void Query(Test&& test, Visit&& visit) const {
+    if (root == k_null) {
+      return;
+    }
+
+    std::vector<u32> stack{root};
+
+    while (!stack.empty()) {
+      auto index = stack.back();
+      auto& node = nodes[index];
+
+      stack.pop_back();
+
+      if (!test(node.box)) {
+        continue;
+      }
+
+      if (node.IsLeaf()) {
+        visit(index);
+      } else {
+        stack.push_back(node.children[0]);
+        stack.push_back(node.children[1]);
+      }
+    }
+  }
+
+private:
+  static constexpr int k_bin_count = 12;
+
+  struct Node {
+    Box3 box;
+    u32 parent = k_null;
+    u32 children[2] {k_null, k_null};
+    u32 item = k_null;
+    bool allocated = false;
+
+    bool IsLeaf() const {
+      return children[0] == k_null;
+    }
+  };
+
+  // A copy of the data of a leaf, so that the build accesses contiguous memory while partitioning the leaves.
+  struct BuildLeaf {
+    Box3 box;
+    Vector3 centroid;
+    u32 node;
+  };
+
+  auto AllocateNode() -> u32 {
+    u32 index;
+
+    if (free_node != k_null) {
+      index = free_node;
+      free_node = nodes[index].parent;
+    } else {
+      index = (u32)nodes.size();
+      nodes.emplace_back();
+    }
+
+    nodes[index] = Node{};
+    nodes[index].allocated = true;
+    return index;
+  }
+
+  void FreeNode(u32 index) {
+    nodes[index].allocated = false;
+    nodes[index].parent = free_node;
+    free_node = index;
+  }
+
+  void SetInternalBox(u32 index, Box3 const& box) {
+    internal_area += box.SurfaceArea() - nodes[index].box.SurfaceArea();
+    nodes[index].box = box;
+  }
+
+  template<typename Visit>
+  void VisitSubtree(Node const& subtree, Visit&& visit) const {
+    std::vector<u32> stack{subtree.children[0], subtree.children[1]};
+
+    while (!stack.empty()) {
+      auto& node = nodes[stack.back()];
+
+      stack.pop_back();
+
+      if (node.IsLeaf()) {
+        visit(node.item);
+      } else {
+        stack.push_back(node.children[0]);
+        stack.push_back(node.children[1]);
+      }
+    }
+  }
+
+  /**
+   * Recompute the bounding boxes of a node and its ancestors from their children.
+   * Stops early once a bounding box does not change.
+   */
+  void Refit(u32 index) {
+    while (index != k_null) {
+      auto& node = nodes[index];
+      auto box = nodes[node.children[0]].box.Union(nodes[node.children[1]].box);
+
+      if (box.Min() == node.box.Min() && box.Max() == node.box.Max()) {
+        break;
+      }
+
+      SetInternalBox(index, box);
+      index = node.parent;
+    }
+  }
+
+  void InsertLeaf(u32 leaf) {
+    if (root == k_null) {
+      root = leaf;
+      nodes[leaf].parent = k_null;
+      return;
+    }
+
+    // Descend towards the sibling that minimizes the increase in surface area, including the increase of its ancestors.
+    auto box = nodes[leaf].box;
+    auto sibling = root;
+
+    while (!nodes[sibling].IsLeaf()) {
+      auto& node = nodes[sibling];
+      auto area = node.box.SurfaceArea();
+      auto combined_area = node.box.Union(box).SurfaceArea();
+
+      // The cost of making the leaf a sibling of this node and the increase in area that any deeper placement inherits.
+      auto cost = 2 * combined_area;
+      auto inherited_cost = 2 * (combined_area - area);
+
+      float child_costs[2];
+
+      for (int i = 0; i < 2; i++) {
+        auto& child = nodes[node.children[i]];
+        auto child_combined_area = child.box.Union(box).SurfaceArea();
+
+        if (child.IsLeaf()) {
+          child_costs[i] = child_combined_area + inherited_cost;
+        } else {
+          child_costs[i] = child_combined_area - child.box.SurfaceArea() + inherited_cost;
+        }
+      }
+
+      if (cost < child_costs[0] && cost < child_costs[1]) {
+        break;
+      }
+
+      sibling = child_costs[0] <= child_costs[1] ? node.children[0] : node.children[1];
+    }
+
+    auto old_parent = nodes[sibling].parent;
+    auto new_parent = AllocateNode();
+
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].children[0] = sibling;
+    nodes[new_parent].children[1] = leaf;
+    nodes[new_parent].box = Box3::Empty();
+    SetInternalBox(new_parent, box.Union(nodes[sibling].box));
+
+    if (old_parent == k_null) {
+      root = new_parent;
+    } else {
+      auto& parent = nodes[old_parent];
+
+      parent.children[parent.children[0] == sibling ? 0 : 1] = new_parent;
+    }
+
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    Refit(old_parent);
+  }
+
+  void RemoveLeaf(u32 leaf) {
+    if (leaf == root) {
+      root = k_null;
+      return;
+    }
+
+    auto parent = nodes[leaf].parent;
+    auto grandparent = nodes[parent].parent;
+    auto sibling = nodes[parent].children[nodes[parent].children[0] == leaf ? 1 : 0];
+
+    SetInternalBox(parent, Box3::Empty());
+    FreeNode(parent);
+
+    if (grandparent == k_null) {
+      root = sibling;
+      nodes[sibling].parent = k_null;
+    } else {
+      auto& node = nodes[grandparent];
+
+      node.children[node.children[0] == parent ? 0 : 1] = sibling;
+      nodes[sibling].parent = grandparent;
+      Refit(grandparent);
+    }
+  }
+
+  /**
+   * Build a subtree over a range of leaves by recursively splitting the range
+   * at the bin boundary with the lowest SAH cost.
+   *
+   * @return the index of the root of the subtree
+   */
+  auto BuildSubtree(std::vector<BuildLeaf>& leaves, size_t begin, size_t end) -> u32 {
+    if (end - begin == 1) {
+      return leaves[begin].node;
+    }
+
+    auto bounds = Box3::Empty();
+    auto centroid_bounds = Box3::Empty();
+
+    for (auto i = begin; i < end; i++) {
+      auto& leaf = leaves[i];
+
+      Grow(bounds, leaf.box.Min(), leaf.box.Max());
+      Grow(centroid_bounds, leaf.centroid, leaf.centroid);
+    }
+
+    auto best_axis = -1;
+    auto best_bin = 0;
+    auto best_cost = std::numeric_limits<float>::infinity();
+
+    for (int axis = 0; axis < 3; axis++) {
+      auto axis_min = centroid_bounds.Min()[axis];
+      auto axis_extent = centroid_bounds.Max()[axis] - axis_min;
+
+      if (axis_extent <= 0) {
+        continue;
+      }
+
+      auto axis_scale = k_bin_count / axis_extent;
+
+      Box3 bin_bounds[k_bin_count];
+      size_t bin_counts[k_bin_count] {};
+
+      for (auto& box : bin_bounds) box = Box3::Empty();
+
+      for (auto i = begin; i < end; i++) {
+        auto& leaf = leaves[i];
+        auto bin = GetBin(leaf.centroid[axis], axis_min, axis_scale);
+
+        Grow(bin_bounds[bin], leaf.box.Min(), leaf.box.Max());
+        bin_counts[bin]++;
+      }
+
+      // Sweep from the right to get the area and count to the right of each bin boundary.
+      float right_areas[k_bin_count];
+      size_t right_counts[k_bin_count];
+      auto right_box = Box3::Empty();
+      size_t right_count = 0;
+
+      for (int bin = k_bin_count - 1; bin > 0; bin--) {
+        right_box = right_box.Union(bin_bounds[bin]);
+        right_count += bin_counts[bin];
+        right_areas[bin] = right_box.SurfaceArea();
+        right_counts[bin] = right_count;
+      }
+
+      auto left_box = Box3::Empty();
+      size_t left_count = 0;
+
+      for (int bin = 1; bin < k_bin_count; bin++) {
+        left_box = left_box.Union(bin_bounds[bin - 1]);
+        left_count += bin_counts[bin - 1];
+
+        if (left_count == 0 || right_counts[bin] == 0) {
+          continue;
+        }
+
+        auto cost = left_box.SurfaceArea() * left_count + right_areas[bin] * right_counts[bin];
+
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_axis = axis;
+          best_bin = bin;
+        }
+      }
+    }
+
+    auto middle = begin + (end - begin) / 2;
+
+    if (best_axis != -1) {
+      auto axis_min = centroid_bounds.Min()[best_axis];
+      auto axis_scale = k_bin_count / (centroid_bounds.Max()[best_axis] - axis_min);
+
+      auto it = std::partition(leaves.begin() + begin, leaves.begin() + end, [&](BuildLeaf const& leaf) {
+        return GetBin(leaf.centroid[best_axis], axis_min, axis_scale) < best_bin;
+      });
+
+      middle = it - leaves.begin();
+    }
+
+    // All centroids coincide or the partition failed, so split the range in half instead.
+    if (middle == begin || middle == end) {
+      middle = begin + (end - begin) / 2;
+    }
+
+    auto left = BuildSubtree(leaves, begin, middle);
+    auto right = BuildSubtree(leaves, middle, end);
+    auto index = AllocateNode();
+
+    nodes[index].children[0] = left;
+    nodes[index].children[1] = right;
+    nodes[index].box = Box3::Empty();
+    SetInternalBox(index, bounds);
+    nodes[left].parent = index;
+    nodes[right].parent = index;
+    return index;
+  }
+
+  /**
+   * Extend a bounding box in-place, which is considerably cheaper than {@link #Box3::Union} in the inner loops of the build.
+   */
+  static void Grow(Box3& box, Vector3 const& min, Vector3 const& max) {
+    auto& box_min = box.Min();
+    auto& box_max = box.Max();
+
+    box_min.X() = std::min(box_min.X(), min.X());
+    box_min.Y() = std::min(box_min.Y(), min.Y());
+    box_min.Z() = std::min(box_min.Z(), min.Z());
+    box_max.X() = std::max(box_max.X(), max.X());
+    box_max.Y() = std::max(box_max.Y(), max.Y());
+    box_max.Z() = std::max(box_max.Z(), max.Z());
+  }
+
+  static auto GetBin(float centroid, float axis_min, float axis_scale) -> int {
+    auto bin = (int)((centroid - axis_min) * axis_scale);
+
+    return std::clamp(bin, 0, k_bin_count - 1);
+  }
+
+  std::vector<Node> nodes;
+  u32 free_node = k_null;
+  u32 root = k_null;
+  float internal_area = 0;
+};
+
+} // namespace Aura
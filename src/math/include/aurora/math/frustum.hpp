@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <aurora/math/box3.hpp>
+#include <aurora/math/box3_array.hpp>
 #include <aurora/math/plane.hpp>
+#include <aurora/math/simd.hpp>
+#include <aurora/math/sphere.hpp>
+#include <aurora/array_view.hpp>
+#include <aurora/integer.hpp>
 
 namespace Aura {
 
@@ -25,6 +31,64 @@ struct Frustum {
     PZ = 5  /**< positive-Z */
   };
 
+  /**
+   * Enumerate the possible results of classifying a volume against this Frustum.
+   */
+  enum class Containment {
+    Outside,      /**< the volume is fully outside */
+    Intersecting, /**< the volume intersects at least one plane */
+    Inside        /**< the volume is fully inside */
+  };
+
+  /**
+   * Enumerate the depth ranges of normalized device coordinates.
+   */
+  enum class DepthRange {
+    NegativeOneToOne, /**< OpenGL-style `-1` to `+1` depth range */
+    ZeroToOne         /**< Vulkan-style `0` to `1` depth range */
+  };
+
+  /**
+   * Extract the Frustum from a projection matrix using the method by Gribb and Hartmann.
+   * If the matrix is a view-projection matrix the planes will be in world space,
+   * if it is a model-view-projection matrix the planes will be in model space.
+   *
+   * @param matrix      the (view-)projection matrix
+   * @param depth_range the depth range of the normalized device coordinates
+   * @return the Frustum
+   */
+  static auto FromMatrix(Matrix4 const& matrix, DepthRange depth_range = DepthRange::ZeroToOne) -> Frustum {
+    Frustum frustum;
+
+    Vector4 row[4];
+
+    for (int i = 0; i < 4; i++) {
+      row[i] = Vector4{matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]};
+    }
+
+    // A point p is inside if -w <= x <= w, -w <= y <= w and (-w or 0) <= z <= w in clip space.
+    const auto set_plane = [&](Side side, Vector4 const& coefficients) {
+      auto normal = coefficients.XYZ();
+      auto recip_length = 1 / normal.Length();
+
+      frustum.SetPlane(side, Plane{normal * recip_length, -coefficients.W() * recip_length});
+    };
+
+    set_plane(Side::NX, row[3] + row[0]);
+    set_plane(Side::PX, row[3] - row[0]);
+    set_plane(Side::NY, row[3] + row[1]);
+    set_plane(Side::PY, row[3] - row[1]);
+    set_plane(Side::PZ, row[3] - row[2]);
+
+    if (depth_range == DepthRange::ZeroToOne) {
+      set_plane(Side::NZ, row[2]);
+    } else {
+      set_plane(Side::NZ, row[3] + row[2]);
+    }
+
+    return frustum;
+  }
+
   /**
    * Get the parametric {@link #Plane} for one {@link #Side} of this Frustum.
    *
@@ -68,7 +132,244 @@ struct Frustum {
     return true;
   }
 
+  /**
+   * Classify an axis-aligned bounding box ({@link #Box3}) against this Frustum.
+   * The outside test is equivalent to {@link #ContainsBox}.
+   *
+   * @param box the bounding box
+   * @return whether the box is fully outside, intersecting or fully inside this Frustum
+   */
+  auto ClassifyBox(Box3 const& box) const -> Containment {
+    auto result = Containment::Inside;
+    auto center = box.Center();
+    auto extent = box.Extent();
+
+    for (auto& plane : planes) {
+      auto distance = plane.GetDistanceToPoint(center);
+      auto radius = std::abs(plane.X()) * extent.X() +
+                    std::abs(plane.Y()) * extent.Y() +
+                    std::abs(plane.Z()) * extent.Z();
+
+      if (distance < -radius) {
+        return Containment::Outside;
+      }
+
+      if (distance < radius) {
+        result = Containment::Intersecting;
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Classify a bounding {@link #Sphere} against this Frustum.
+   * This is cheaper than testing a {@link #Box3}, but less precise for intersecting volumes.
+   *
+   * @param sphere the bounding sphere
+   * @return whether the sphere is fully outside, intersecting or fully inside this Frustum
+   */
+  auto ClassifySphere(Sphere const& sphere) const -> Containment {
+    auto result = Containment::Inside;
+
+    for (auto& plane : planes) {
+      auto distance = plane.GetDistanceToPoint(sphere.Center());
+
+      if (distance < -sphere.Radius()) {
+        return Containment::Outside;
+      }
+
+      if (distance < sphere.Radius()) {
+        result = Containment::Intersecting;
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Calculate for a list of axis-aligned bounding boxes whether each of them is
+   * at least partially contained within this Frustum.
+   * The test is equivalent to {@link #ContainsBox}, but processes multiple boxes at once using SIMD.
+   *
+   * @param boxes        the bounding boxes in center-extent form
+   * @param visible_mask array of `boxes.Size()` bytes that receives `1` for each box that is (partially) inside and `0` otherwise
+   */
+  void CullBoxes(Box3Array const& boxes, u8* visible_mask) const {
+    CullBoxes(
+      boxes.CenterX(), boxes.CenterY(), boxes.CenterZ(),
+      boxes.ExtentX(), boxes.ExtentY(), boxes.ExtentZ(),
+      boxes.Size(), visible_mask
+    );
+  }
+
+  /**
+   * Calculate for a list of axis-aligned bounding boxes whether each of them is
+   * at least partially contained within this Frustum.
+   * The boxes are converted to center-extent form in small batches, prefer the {@link #Box3Array} overload if possible.
+   *
+   * @param boxes        the bounding boxes
+   * @param visible_mask array of `boxes.size()` bytes that receives `1` for each box that is (partially) inside and `0` otherwise
+   */
+  void CullBoxes(ArrayView<Box3 const> boxes, u8* visible_mask) const {
+    constexpr size_t k_batch_size = 64;
+
+    float center[3][k_batch_size];
+    float extent[3][k_batch_size];
+
+    for (size_t base = 0; base < boxes.size(); base += k_batch_size) {
+      auto count = std::min(k_batch_size, boxes.size() - base);
+
+      for (size_t i = 0; i < count; i++) {
+        auto& box = boxes[base + i];
+
+        for (int j = 0; j < 3; j++) {
+          center[j][i] = (box.Min()[j] + box.Max()[j]) * 0.5f;
+          extent[j][i] = (box.Max()[j] - box.Min()[j]) * 0.5f;
+        }
+      }
+
+      CullBoxes(
+        center[0], center[1], center[2],
+        extent[0], extent[1], extent[2],
+        count, &visible_mask[base]
+      );
+    }
+  }
+
 private:
+  void CullBoxes(
+    float const* center_x,
+    float const* center_y,
+    float const* center_z,
+    float const* extent_x,
+    float const* extent_y,
+    float const* extent_z,
+    size_t count,
+    u8* visible_mask
+  ) const {
+    /*
+     * A box is outside of a plane if the vertex furthest along the plane normal is behind the plane.
+     * In center-extent form the signed distance of that vertex is:
+     *   dot(normal, center) - distance + dot(abs(normal), extent)
+     */
+    size_t i = 0;
+
+#if defined(AURA_MATH_AVX)
+    {
+      __m256 normal_x[6], normal_y[6], normal_z[6];
+      __m256 abs_normal_x[6], abs_normal_y[6], abs_normal_z[6];
+      __m256 distance[6];
+
+      for (int j = 0; j < 6; j++) {
+        normal_x[j] = _mm256_set1_ps(planes[j].X());
+        normal_y[j] = _mm256_set1_ps(planes[j].Y());
+        normal_z[j] = _mm256_set1_ps(planes[j].Z());
+        abs_normal_x[j] = _mm256_set1_ps(std::abs(planes[j].X()));
+        abs_normal_y[j] = _mm256_set1_ps(std::abs(planes[j].Y()));
+        abs_normal_z[j] = _mm256_set1_ps(std::abs(planes[j].Z()));
+        distance[j] = _mm256_set1_ps(planes[j].GetDistance());
+      }
+
+      const auto zero = _mm256_setzero_ps();
+
+      for (; i + 8 <= count; i += 8) {
+        auto cx = _mm256_loadu_ps(&center_x[i]);
+        auto cy = _mm256_loadu_ps(&center_y[i]);
+        auto cz = _mm256_loadu_ps(&center_z[i]);
+        auto ex = _mm256_loadu_ps(&extent_x[i]);
+        auto ey = _mm256_loadu_ps(&extent_y[i]);
+        auto ez = _mm256_loadu_ps(&extent_z[i]);
+        auto visible = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+
+        for (int j = 0; j < 6; j++) {
+          auto d = _mm256_mul_ps(cx, normal_x[j]);
+          d = _mm256_add_ps(d, _mm256_mul_ps(cy, normal_y[j]));
+          d = _mm256_add_ps(d, _mm256_mul_ps(cz, normal_z[j]));
+          d = _mm256_sub_ps(d, distance[j]);
+
+          auto r = _mm256_mul_ps(ex, abs_normal_x[j]);
+          r = _mm256_add_ps(r, _mm256_mul_ps(ey, abs_normal_y[j]));
+          r = _mm256_add_ps(r, _mm256_mul_ps(ez, abs_normal_z[j]));
+
+          visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_GE_OQ));
+        }
+
+        auto bits = _mm256_movemask_ps(visible);
+
+        for (int j = 0; j < 8; j++) {
+          visible_mask[i + j] = (u8)((bits >> j) & 1);
+        }
+      }
+    }
+#endif
+
+#if defined(AURA_MATH_SSE)
+    {
+      __m128 normal_x[6], normal_y[6], normal_z[6];
+      __m128 abs_normal_x[6], abs_normal_y[6], abs_normal_z[6];
+      __m128 distance[6];
+
+      for (int j = 0; j < 6; j++) {
+        normal_x[j] = _mm_set1_ps(planes[j].X());
+        normal_y[j] = _mm_set1_ps(planes[j].Y());
+        normal_z[j] = _mm_set1_ps(planes[j].Z());
+        abs_normal_x[j] = _mm_set1_ps(std::abs(planes[j].X()));
+        abs_normal_y[j] = _mm_set1_ps(std::abs(planes[j].Y()));
+        abs_normal_z[j] = _mm_set1_ps(std::abs(planes[j].Z()));
+        distance[j] = _mm_set1_ps(planes[j].GetDistance());
+      }
+
+      const auto zero = _mm_setzero_ps();
+
+      for (; i + 4 <= count; i += 4) {
+        auto cx = _mm_loadu_ps(&center_x[i]);
+        auto cy = _mm_loadu_ps(&center_y[i]);
+        auto cz = _mm_loadu_ps(&center_z[i]);
+        auto ex = _mm_loadu_ps(&extent_x[i]);
+        auto ey = _mm_loadu_ps(&extent_y[i]);
+        auto ez = _mm_loadu_ps(&extent_z[i]);
+        auto visible = _mm_cmpeq_ps(zero, zero);
+
+        for (int j = 0; j < 6; j++) {
+          auto d = _mm_mul_ps(cx, normal_x[j]);
+          d = _mm_add_ps(d, _mm_mul_ps(cy, normal_y[j]));
+          d = _mm_add_ps(d, _mm_mul_ps(cz, normal_z[j]));
+          d = _mm_sub_ps(d, distance[j]);
+
+          auto r = _mm_mul_ps(ex, abs_normal_x[j]);
+          r = _mm_add_ps(r, _mm_mul_ps(ey, abs_normal_y[j]));
+          r = _mm_add_ps(r, _mm_mul_ps(ez, abs_normal_z[j]));
+
+          visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(d, r), zero));
+        }
+
+        auto bits = _mm_movemask_ps(visible);
+
+        for (int j = 0; j < 4; j++) {
+          visible_mask[i + j] = (u8)((bits >> j) & 1);
+        }
+      }
+    }
+#endif
+
+    for (; i < count; i++) {
+      bool visible = true;
+
+      for (auto& plane : planes) {
+        auto d = center_x[i] * plane.X() + center_y[i] * plane.Y() + center_z[i] * plane.Z() - plane.GetDistance();
+        auto r = extent_x[i] * std::abs(plane.X()) + extent_y[i] * std::abs(plane.Y()) + extent_z[i] * std::abs(plane.Z());
+
+        if (d + r < 0) {
+          visible = false;
+          break;
+        }
+      }
+
+      visible_mask[i] = visible ? 1 : 0;
+    }
+  }
+
   Plane planes[6];
 };
 
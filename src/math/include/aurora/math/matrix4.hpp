@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cmath>
+#include <aurora/math/simd.hpp>
 #include <aurora/math/vector.hpp>
 
 #ifndef M_PI
@@ -174,12 +175,254 @@ private:
 
 } // namespace Aura::detail
 
+/**
+ * Describes the structure of a transformation matrix, which allows picking a cheaper inversion algorithm.
+ */
+enum class MatrixClass {
+  General, /**< arbitrary 4x4 matrix, for example a projection */
+  Affine,  /**< last row is (0, 0, 0, 1), the upper 3x3 part is an arbitrary invertible matrix */
+  Rigid    /**< rotation and translation, optionally combined with an uniform scale */
+};
+
 /**
  * A 4x4 float matrix
+ *
+ * Multiplication and inversion are implemented with SSE (and AVX where it helps) when available.
+ * The results are bit-identical to the scalar reference implementation in detail::Matrix4.
  */
 struct Matrix4 final : detail::Matrix4<Matrix4, Vector4, float> {
   using detail::Matrix4<Matrix4, Vector4, float>::Matrix4;
 
+#if defined(AURA_MATH_SSE)
+  /**
+   * Apply this matrix on a four-dimensional vector.
+   *
+   * @param vec the vector
+   * @return the result vector
+   */
+  auto operator*(Vector4 const& vec) const -> Vector4 {
+    auto v = vec.ToSSE();
+    auto result = _mm_setzero_ps();
+    result = _mm_add_ps(result, _mm_mul_ps(X().ToSSE(), _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))));
+    result = _mm_add_ps(result, _mm_mul_ps(Y().ToSSE(), _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    result = _mm_add_ps(result, _mm_mul_ps(Z().ToSSE(), _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+    result = _mm_add_ps(result, _mm_mul_ps(W().ToSSE(), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+    return Vector4::FromSSE(result);
+  }
+
+  /**
+   * Apply this matrix on each column vector of another matrix.
+   * Store the result in a new matrix.
+   *
+   * @param other the other matrix
+   * @return the result matrix
+   */
+  auto operator*(Matrix4 const& other) const -> Matrix4 {
+    Matrix4 result;
+
+#if defined(AURA_MATH_AVX)
+    // Compute two result columns at once: the lower lane holds column i, the upper lane column i + 1.
+    auto x = _mm256_broadcast_ps((__m128 const*)X().Data());
+    auto y = _mm256_broadcast_ps((__m128 const*)Y().Data());
+    auto z = _mm256_broadcast_ps((__m128 const*)Z().Data());
+    auto w = _mm256_broadcast_ps((__m128 const*)W().Data());
+
+    for (uint i = 0; i < 4; i += 2) {
+      auto v = _mm256_loadu_ps(other[i].Data());
+      auto column = _mm256_setzero_ps();
+      column = _mm256_add_ps(column, _mm256_mul_ps(x, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))));
+      column = _mm256_add_ps(column, _mm256_mul_ps(y, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+      column = _mm256_add_ps(column, _mm256_mul_ps(z, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+      column = _mm256_add_ps(column, _mm256_mul_ps(w, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+      _mm256_storeu_ps(result[i].Data(), column);
+    }
+#else
+    for (uint i = 0; i < 4; i++) {
+      result[i] = *this * other[i];
+    }
+#endif
+
+    return result;
+  }
+
+  /**
+   * Calculate the inverse of this matrix.
+   * If this matrix is not invertable (determinant = 0) then the operation is undefined.
+   * @return the inverted matrix
+   */
+  auto Inverse() const -> Matrix4 {
+    /*
+     * This evaluates the same cofactor expansion as detail::Matrix4::Inverse(),
+     * but computes one column of the result (four cofactors) per instruction.
+     *
+     * With rows r and s fixed, the 2x2 minors aCDrs are needed for the column pairs
+     *   a = (2,3) (2,3) (1,3) (1,2)
+     *   b = (1,3) (0,3) (0,3) (0,2)
+     *   c = (1,2) (0,2) (0,1) (0,1)
+     * and the cofactors of result column j are `row[1,0,0,0] * a - row[2,2,1,1] * b + row[3,3,3,2] * c`,
+     * where `row` is row 1 of this matrix for j = 0 and row 0 otherwise.
+     */
+    auto row0 = X().ToSSE();
+    auto row1 = Y().ToSSE();
+    auto row2 = Z().ToSSE();
+    auto row3 = W().ToSSE();
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    const auto shuffle_1000 = [](__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 1)); };
+    const auto shuffle_2211 = [](__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 2, 2)); };
+    const auto shuffle_3332 = [](__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 3, 3)); };
+
+    const auto minors = [&](__m128 r, __m128 s, __m128& a, __m128& b, __m128& c) {
+      auto r_1000 = shuffle_1000(r);
+      auto r_2211 = shuffle_2211(r);
+      auto r_3332 = shuffle_3332(r);
+      auto s_1000 = shuffle_1000(s);
+      auto s_2211 = shuffle_2211(s);
+      auto s_3332 = shuffle_3332(s);
+
+      a = _mm_sub_ps(_mm_mul_ps(r_2211, s_3332), _mm_mul_ps(r_3332, s_2211));
+      b = _mm_sub_ps(_mm_mul_ps(r_1000, s_3332), _mm_mul_ps(r_3332, s_1000));
+      c = _mm_sub_ps(_mm_mul_ps(r_1000, s_2211), _mm_mul_ps(r_2211, s_1000));
+    };
+
+    const auto cofactors = [&](__m128 row, __m128 a, __m128 b, __m128 c, __m128 sign) {
+      auto result = _mm_sub_ps(_mm_mul_ps(shuffle_1000(row), a), _mm_mul_ps(shuffle_2211(row), b));
+      result = _mm_add_ps(result, _mm_mul_ps(shuffle_3332(row), c));
+      return _mm_xor_ps(result, sign);
+    };
+
+    __m128 a23, b23, c23;
+    __m128 a13, b13, c13;
+    __m128 a12, b12, c12;
+    minors(row2, row3, a23, b23, c23);
+    minors(row1, row3, a13, b13, c13);
+    minors(row1, row2, a12, b12, c12);
+
+    const auto sign_pnpn = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const auto sign_npnp = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+    auto column0 = cofactors(row1, a23, b23, c23, sign_pnpn);
+    auto column1 = cofactors(row0, a23, b23, c23, sign_npnp);
+    auto column2 = cofactors(row0, a13, b13, c13, sign_pnpn);
+    auto column3 = cofactors(row0, a12, b12, c12, sign_npnp);
+
+    // Sum up the products in the same order as the scalar implementation.
+    float products[4];
+    _mm_storeu_ps(products, _mm_mul_ps(row0, column0));
+    auto det = products[0] + products[1] + products[2] + products[3];
+    auto recip_det = _mm_set1_ps(1 / det);
+
+    Matrix4 result;
+    result.X() = Vector4::FromSSE(_mm_mul_ps(recip_det, column0));
+    result.Y() = Vector4::FromSSE(_mm_mul_ps(recip_det, column1));
+    result.Z() = Vector4::FromSSE(_mm_mul_ps(recip_det, column2));
+    result.W() = Vector4::FromSSE(_mm_mul_ps(recip_det, column3));
+    return result;
+  }
+#endif
+
+  using detail::Matrix4<Matrix4, Vector4, float>::Inverse;
+
+  /**
+   * Calculate the inverse of this matrix, assuming that it is an affine transform.
+   * The last row of the matrix is assumed to be (0, 0, 0, 1) and is not read.
+   *
+   * @return the inverted matrix
+   */
+  auto InverseAffine() const -> Matrix4 {
+#if defined(AURA_MATH_SSE)
+    const auto shuffle_yzx = [](__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); };
+    const auto shuffle_zxy = [](__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)); };
+    const auto cross = [&](__m128 u, __m128 v) {
+      return _mm_sub_ps(
+        _mm_mul_ps(shuffle_yzx(u), shuffle_zxy(v)),
+        _mm_mul_ps(shuffle_zxy(u), shuffle_yzx(v))
+      );
+    };
+
+    auto a = X().ToSSE();
+    auto b = Y().ToSSE();
+    auto c = Z().ToSSE();
+
+    auto row0 = cross(b, c);
+    auto row1 = cross(c, a);
+    auto row2 = cross(a, b);
+    auto row3 = _mm_setzero_ps();
+
+    float det[4];
+    _mm_storeu_ps(det, _mm_mul_ps(a, row0));
+    auto recip_det = _mm_set1_ps(1 / (det[0] + det[1] + det[2]));
+
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    return FromInverseColumns(_mm_mul_ps(row0, recip_det), _mm_mul_ps(row1, recip_det), _mm_mul_ps(row2, recip_det));
+#else
+    auto a = X().XYZ();
+    auto b = Y().XYZ();
+    auto c = Z().XYZ();
+
+    // The rows of the inverse 3x3 matrix are the cross products of the columns divided by the determinant.
+    auto row0 = b.Cross(c);
+    auto row1 = c.Cross(a);
+    auto row2 = a.Cross(b);
+    auto recip_det = 1 / a.Dot(row0);
+
+    return FromInverseRows(row0 * recip_det, row1 * recip_det, row2 * recip_det);
+#endif
+  }
+
+  /**
+   * Calculate the inverse of this matrix, assuming that it is a rigid-body transform
+   * (rotation and translation) optionally combined with an uniform scale.
+   * The last row of the matrix is assumed to be (0, 0, 0, 1) and is not read.
+   *
+   * @return the inverted matrix
+   */
+  auto InverseRigid() const -> Matrix4 {
+    // The inverse of s * R is R^T / s, which equals the transpose divided by s^2.
+    // Thus the rows of the inverse 3x3 matrix are the columns of this matrix divided by s^2.
+#if defined(AURA_MATH_SSE)
+    auto column0 = X().ToSSE();
+    auto column1 = Y().ToSSE();
+    auto column2 = Z().ToSSE();
+    auto column3 = _mm_setzero_ps();
+
+    float scale2[4];
+    _mm_storeu_ps(scale2, _mm_mul_ps(column0, column0));
+    auto recip_scale2 = _mm_set1_ps(1 / (scale2[0] + scale2[1] + scale2[2]));
+
+    _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+    return FromInverseColumns(
+      _mm_mul_ps(column0, recip_scale2),
+      _mm_mul_ps(column1, recip_scale2),
+      _mm_mul_ps(column2, recip_scale2)
+    );
+#else
+    auto a = X().XYZ();
+    auto b = Y().XYZ();
+    auto c = Z().XYZ();
+
+    auto recip_scale2 = 1 / a.Dot(a);
+
+    return FromInverseRows(a * recip_scale2, b * recip_scale2, c * recip_scale2);
+#endif
+  }
+
+  /**
+   * Calculate the inverse of this matrix using the cheapest algorithm for the given matrix class.
+   *
+   * @param matrix_class the structure of this matrix
+   * @return the inverted matrix
+   */
+  auto Inverse(MatrixClass matrix_class) const -> Matrix4 {
+    switch (matrix_class) {
+      case MatrixClass::Rigid:  return InverseRigid();
+      case MatrixClass::Affine: return InverseAffine();
+      default: return Inverse();
+    }
+  }
+
   /**
    * Create a 3D scale matrix from three scalar values.
    *
@@ -388,6 +631,54 @@ struct Matrix4 final : detail::Matrix4<Matrix4, Vector4, float> {
       0, 0, 0, 1
     }};
   }
+
+private:
+#if defined(AURA_MATH_SSE)
+  /**
+   * Build the inverse of an affine transform from the columns of its inverted upper 3x3 part.
+   * The fourth lane of each column is ignored.
+   */
+  auto FromInverseColumns(__m128 column0, __m128 column1, __m128 column2) const -> Matrix4 {
+    // Clear the fourth lane instead of relying on it being zero, which may be -0 after scaling by a negative determinant.
+    const auto mask_xyz = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+    column0 = _mm_and_ps(column0, mask_xyz);
+    column1 = _mm_and_ps(column1, mask_xyz);
+    column2 = _mm_and_ps(column2, mask_xyz);
+
+    auto t = W().ToSSE();
+
+    auto translation = _mm_mul_ps(column0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)));
+    translation = _mm_add_ps(translation, _mm_mul_ps(column1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+    translation = _mm_add_ps(translation, _mm_mul_ps(column2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+
+    // Negate by flipping the sign bit like the scalar code does, since 0 - x would turn -0 into +0.
+    translation = _mm_xor_ps(translation, _mm_set1_ps(-0.0f));
+    translation = _mm_or_ps(_mm_and_ps(translation, mask_xyz), _mm_setr_ps(0, 0, 0, 1));
+
+    Matrix4 result;
+    result.X() = Vector4::FromSSE(column0);
+    result.Y() = Vector4::FromSSE(column1);
+    result.Z() = Vector4::FromSSE(column2);
+    result.W() = Vector4::FromSSE(translation);
+    return result;
+  }
+#endif
+
+  /**
+   * Build the inverse of an affine transform from the rows of its inverted upper 3x3 part.
+   * The translation is the negated translation of this matrix transformed by the inverted 3x3 part.
+   */
+  auto FromInverseRows(Vector3 const& row0, Vector3 const& row1, Vector3 const& row2) const -> Matrix4 {
+    auto t = W().XYZ();
+
+    return Matrix4{{
+      row0.X(), row0.Y(), row0.Z(), -row0.Dot(t),
+      row1.X(), row1.Y(), row1.Z(), -row1.Dot(t),
+      row2.X(), row2.Y(), row2.Z(), -row2.Dot(t),
+      0, 0, 0, 1
+    }};
+  }
 };
 
 } // namespace Aura
@@ -0,0 +1,1029 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/batch.hpp>
+#include <aurora/math/simd.hpp>
+#include <aurora/math/vector.hpp>
+#include <aurora/array_view.hpp>
+#include <aurora/integer.hpp>
+#include <aurora/strided_array_view.hpp>
+#include <cmath>
+#include <cstring>
+
+/**
+ * Quantized storage formats for vertex data and the kernels that convert between them and float32.
+ *
+ * The quantized types are storage-only: they expose their raw components through the usual
+ * vector accessors and are converted to and from float vectors for arithmetic.
+ * Their memory layout matches the corresponding Vulkan vertex formats
+ * (i.e. R16G16B16_SFLOAT, R16G16_SNORM, A2B10G10R10_UNORM_PACK32).
+ *
+ * The maximum round-trip error for values inside the representable range is noted on each format.
+ * Absolute error bounds may additionally be exceeded by up to 2^-24 (one float ulp at 1.0),
+ * because the input itself and the decoded value are rounded to float.
+ * The batch kernels are bit-identical to the scalar conversions, except for NaN payloads on F16C targets.
+ */
+
+namespace Aura {
+
+/**
+ * Convert a float to an IEEE 754 binary16 (half-float) value with round-to-nearest-even.
+ * Values beyond the half-float range become infinity, NaN becomes a quiet NaN.
+ * For normal half-floats the relative round-trip error is at most 2^-11 (about 4.9e-4),
+ * for values below 2^-14 the absolute round-trip error is at most 2^-25.
+ *
+ * @param value the float value
+ * @return the half-float bits
+ */
+inline auto FloatToHalf(float value) -> u16 {
+  // See: https://gist.github.com/rygorous/2156668 (float_to_half_fast3_rtne)
+  constexpr u32 k_f32_infinity = 255 << 23;
+  constexpr u32 k_f16_max = (127 + 16) << 23;
+  constexpr u32 k_denorm_magic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+  u32 bits;
+  std::memcpy(&bits, &value, sizeof(float));
+
+  u32 sign = bits & 0x80000000;
+  u32 result;
+
+  bits ^= sign;
+
+  if (bits >= k_f16_max) {
+    result = bits > k_f32_infinity ? 0x7E00 : 0x7C00;
+  } else if (bits < (113 << 23)) {
+    // The result is subnormal (or zero): let the FPU do the rounding by adding a large magic number.
+    float magic;
+    std::memcpy(&magic, &k_denorm_magic, sizeof(float));
+    std::memcpy(&value, &bits, sizeof(float));
+    value += magic;
+    std::memcpy(&result, &value, sizeof(float));
+    result -= k_denorm_magic;
+  } else {
+    u32 mantissa_odd = (bits >> 13) & 1;
+    bits += ((u32)(15 - 127) << 23) + 0xFFF + mantissa_odd;
+    result = bits >> 13;
+  }
+
+  return (u16)(result | (sign >> 16));
+}
+
+/**
+ * Convert an IEEE 754 binary16 (half-float) value to a float. This conversion is exact.
+ *
+ * @param half the half-float bits
+ * @return the float value
+ */
+inline auto HalfToFloat(u16 half) -> float {
+  // See: https://gist.github.com/rygorous/2144712 (half_to_float_fast5)
+  constexpr u32 k_shifted_exponent = 0x7C00 << 13;
+  constexpr u32 k_magic = 113 << 23;
+
+  u32 bits = (half & 0x7FFF) << 13;
+  u32 exponent = bits & k_shifted_exponent;
+
+  bits += (127 - 15) << 23;
+
+  if (exponent == k_shifted_exponent) {
+    bits += (128 - 16) << 23;
+  } else if (exponent == 0) {
+    float value;
+    float magic;
+    bits += 1 << 23;
+    std::memcpy(&value, &bits, sizeof(float));
+    std::memcpy(&magic, &k_magic, sizeof(float));
+    value -= magic;
+    std::memcpy(&bits, &value, sizeof(float));
+  }
+
+  bits |= (half & 0x8000) << 16;
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+namespace detail {
+
+/**
+ * Clamp a value to [min, max] with the semantics of SSE minps/maxps, so that NaN clamps to `max`.
+ */
+inline auto ClampNormalized(float value, float min, float max) -> float {
+  value = value < max ? value : max;
+  value = value > min ? value : min;
+  return value;
+}
+
+} // namespace Aura::detail
+
+/**
+ * Convert a float in [-1, 1] to a signed normalized 16-bit integer.
+ * Values outside the range are clamped. The absolute round-trip error is at most 1 / 65534 (about 1.5e-5).
+ *
+ * @param value the float value
+ * @return the signed normalized integer
+ */
+inline auto FloatToSNorm16(float value) -> s16 {
+  return (s16)std::lrint(detail::ClampNormalized(value, -1, 1) * 32767.0f);
+}
+
+/**
+ * Convert a signed normalized 16-bit integer to a float in [-1, 1].
+ *
+ * @param value the signed normalized integer
+ * @return the float value
+ */
+inline auto SNorm16ToFloat(s16 value) -> float {
+  auto result = (float)value * (1.0f / 32767.0f);
+  return result > -1.0f ? result : -1.0f;
+}
+
+/**
+ * Convert a float in [0, 1] to an unsigned normalized 16-bit integer.
+ * Values outside the range are clamped. The absolute round-trip error is at most 1 / 131070 (about 7.6e-6).
+ *
+ * @param value the float value
+ * @return the unsigned normalized integer
+ */
+inline auto FloatToUNorm16(float value) -> u16 {
+  return (u16)std::lrint(detail::ClampNormalized(value, 0, 1) * 65535.0f);
+}
+
+/**
+ * Convert an unsigned normalized 16-bit integer to a float in [0, 1].
+ *
+ * @param value the unsigned normalized integer
+ * @return the float value
+ */
+inline auto UNorm16ToFloat(u16 value) -> float {
+  return (float)value * (1.0f / 65535.0f);
+}
+
+/**
+ * A two-dimensional half-float vector (R16G16_SFLOAT).
+ * The components hold the raw half-float bits, see {@link #FloatToHalf} for the round-trip error.
+ */
+struct Vector2h final : detail::Vector2<Vector2h, u16> {
+  using detail::Vector2<Vector2h, u16>::Vector2;
+
+  /**
+   * Construct a Vector2h by converting a float vector.
+   */
+  explicit Vector2h(Aura::Vector2 const& vec) {
+    for (int i = 0; i < 2; i++) data[i] = FloatToHalf(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector2 {
+    return Aura::Vector2{HalfToFloat(data[0]), HalfToFloat(data[1])};
+  }
+};
+
+/**
+ * A three-dimensional half-float vector (R16G16B16_SFLOAT).
+ * The components hold the raw half-float bits, see {@link #FloatToHalf} for the round-trip error.
+ */
+struct Vector3h final : detail::Vector3<Vector3h, u16> {
+  using detail::Vector3<Vector3h, u16>::Vector3;
+
+  /**
+   * Construct a Vector3h by converting a float vector.
+   */
+  explicit Vector3h(Aura::Vector3 const& vec) {
+    for (int i = 0; i < 3; i++) data[i] = FloatToHalf(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector3 {
+    return Aura::Vector3{HalfToFloat(data[0]), HalfToFloat(data[1]), HalfToFloat(data[2])};
+  }
+};
+
+/**
+ * A four-dimensional half-float vector (R16G16B16A16_SFLOAT).
+ * The components hold the raw half-float bits, see {@link #FloatToHalf} for the round-trip error.
+ */
+struct Vector4h final : detail::Vector4<Vector4h, Vector3h, u16> {
+  using detail::Vector4<Vector4h, Vector3h, u16>::Vector4;
+
+  /**
+   * Construct a Vector4h by converting a float vector.
+   */
+  explicit Vector4h(Aura::Vector4 const& vec) {
+    for (int i = 0; i < 4; i++) data[i] = FloatToHalf(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector4 {
+    return Aura::Vector4{HalfToFloat(data[0]), HalfToFloat(data[1]), HalfToFloat(data[2]), HalfToFloat(data[3])};
+  }
+};
+
+/**
+ * A two-dimensional signed normalized 16-bit vector (R16G16_SNORM).
+ * See {@link #FloatToSNorm16} for the round-trip error.
+ */
+struct Vector2sn16 final : detail::Vector2<Vector2sn16, s16> {
+  using detail::Vector2<Vector2sn16, s16>::Vector2;
+
+  /**
+   * Construct a Vector2sn16 by converting a float vector.
+   */
+  explicit Vector2sn16(Aura::Vector2 const& vec) {
+    for (int i = 0; i < 2; i++) data[i] = FloatToSNorm16(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector2 {
+    return Aura::Vector2{SNorm16ToFloat(data[0]), SNorm16ToFloat(data[1])};
+  }
+};
+
+/**
+ * A three-dimensional signed normalized 16-bit vector (R16G16B16_SNORM).
+ * See {@link #FloatToSNorm16} for the round-trip error.
+ */
+struct Vector3sn16 final : detail::Vector3<Vector3sn16, s16> {
+  using detail::Vector3<Vector3sn16, s16>::Vector3;
+
+  /**
+   * Construct a Vector3sn16 by converting a float vector.
+   */
+  explicit Vector3sn16(Aura::Vector3 const& vec) {
+    for (int i = 0; i < 3; i++) data[i] = FloatToSNorm16(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector3 {
+    return Aura::Vector3{SNorm16ToFloat(data[0]), SNorm16ToFloat(data[1]), SNorm16ToFloat(data[2])};
+  }
+};
+
+/**
+ * A four-dimensional signed normalized 16-bit vector (R16G16B16A16_SNORM).
+ * See {@link #FloatToSNorm16} for the round-trip error.
+ */
+struct Vector4sn16 final : detail::Vector4<Vector4sn16, Vector3sn16, s16> {
+  using detail::Vector4<Vector4sn16, Vector3sn16, s16>::Vector4;
+
+  /**
+   * Construct a Vector4sn16 by converting a float vector.
+   */
+  explicit Vector4sn16(Aura::Vector4 const& vec) {
+    for (int i = 0; i < 4; i++) data[i] = FloatToSNorm16(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector4 {
+    return Aura::Vector4{SNorm16ToFloat(data[0]), SNorm16ToFloat(data[1]), SNorm16ToFloat(data[2]), SNorm16ToFloat(data[3])};
+  }
+};
+
+/**
+ * A two-dimensional unsigned normalized 16-bit vector (R16G16_UNORM).
+ * See {@link #FloatToUNorm16} for the round-trip error.
+ */
+struct Vector2un16 final : detail::Vector2<Vector2un16, u16> {
+  using detail::Vector2<Vector2un16, u16>::Vector2;
+
+  /**
+   * Construct a Vector2un16 by converting a float vector.
+   */
+  explicit Vector2un16(Aura::Vector2 const& vec) {
+    for (int i = 0; i < 2; i++) data[i] = FloatToUNorm16(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector2 {
+    return Aura::Vector2{UNorm16ToFloat(data[0]), UNorm16ToFloat(data[1])};
+  }
+};
+
+/**
+ * A three-dimensional unsigned normalized 16-bit vector (R16G16B16_UNORM).
+ * See {@link #FloatToUNorm16} for the round-trip error.
+ */
+struct Vector3un16 final : detail::Vector3<Vector3un16, u16> {
+  using detail::Vector3<Vector3un16, u16>::Vector3;
+
+  /**
+   * Construct a Vector3un16 by converting a float vector.
+   */
+  explicit Vector3un16(Aura::Vector3 const& vec) {
+    for (int i = 0; i < 3; i++) data[i] = FloatToUNorm16(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector3 {
+    return Aura::Vector3{UNorm16ToFloat(data[0]), UNorm16ToFloat(data[1]), UNorm16ToFloat(data[2])};
+  }
+};
+
+/**
+ * A four-dimensional unsigned normalized 16-bit vector (R16G16B16A16_UNORM).
+ * See {@link #FloatToUNorm16} for the round-trip error.
+ */
+struct Vector4un16 final : detail::Vector4<Vector4un16, Vector3un16, u16> {
+  using detail::Vector4<Vector4un16, Vector3un16, u16>::Vector4;
+
+  /**
+   * Construct a Vector4un16 by converting a float vector.
+   */
+  explicit Vector4un16(Aura::Vector4 const& vec) {
+    for (int i = 0; i < 4; i++) data[i] = FloatToUNorm16(vec[i]);
+  }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Aura::Vector4 {
+    return Aura::Vector4{UNorm16ToFloat(data[0]), UNorm16ToFloat(data[1]), UNorm16ToFloat(data[2]), UNorm16ToFloat(data[3])};
+  }
+};
+
+/**
+ * A unit vector encoded as two signed normalized 16-bit components using the octahedral mapping (R16G16_SNORM).
+ * See: "A Survey of Efficient Representations for Independent Unit Vectors" (Cigolle et al. 2014)
+ *
+ * The maximum angular round-trip error is about 0.0037 degrees (6.5e-5 radians).
+ */
+struct OctahedralNormal final : detail::Vector2<OctahedralNormal, s16> {
+  using detail::Vector2<OctahedralNormal, s16>::Vector2;
+
+  /**
+   * Construct an OctahedralNormal by encoding a unit vector.
+   * If the vector is the zero vector then this operation is undefined.
+   *
+   * @param normal the unit vector, does not need to be normalised
+   */
+  explicit OctahedralNormal(Vector3 const& normal) {
+    auto scale = 1.0f / (std::abs(normal.X()) + std::abs(normal.Y()) + std::abs(normal.Z()));
+    auto x = normal.X() * scale;
+    auto y = normal.Y() * scale;
+
+    // Fold the lower hemisphere over the diagonals of the upper hemisphere.
+    if (normal.Z() < 0) {
+      auto folded_x = (1.0f - std::abs(y)) * std::copysign(1.0f, x);
+      auto folded_y = (1.0f - std::abs(x)) * std::copysign(1.0f, y);
+      x = folded_x;
+      y = folded_y;
+    }
+
+    data[0] = FloatToSNorm16(x);
+    data[1] = FloatToSNorm16(y);
+  }
+
+  /**
+   * Decode the unit vector.
+   * @return the normalised unit vector
+   */
+  auto ToFloat() const -> Vector3 {
+    auto x = SNorm16ToFloat(data[0]);
+    auto y = SNorm16ToFloat(data[1]);
+    auto z = 1.0f - std::abs(x) - std::abs(y);
+    auto t = -z > 0.0f ? -z : 0.0f;
+
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    auto scale = 1.0f / std::sqrt(x * x + y * y + z * z);
+
+    return Vector3{x * scale, y * scale, z * scale};
+  }
+};
+
+/**
+ * A four-dimensional vector packed into 32 bits with 10 bits for x, y and z and 2 bits for w (A2B10G10R10_UNORM_PACK32).
+ * The maximum absolute round-trip error is 1 / 2046 (about 4.9e-4) for x, y and z and 1 / 6 for w.
+ */
+struct UNorm1010102 {
+  /**
+   * Default constructor. The vector is initialised to (0, 0, 0, 0).
+   */
+  UNorm1010102() {}
+
+  /**
+   * Construct a UNorm1010102 from its packed bits.
+   */
+  explicit UNorm1010102(u32 bits) : bits(bits) {}
+
+  /**
+   * Construct a UNorm1010102 by converting a float vector. Components are clamped to [0, 1].
+   */
+  explicit UNorm1010102(Vector4 const& vec) {
+    bits = (u32)std::lrint(detail::ClampNormalized(vec.X(), 0, 1) * 1023.0f) |
+           (u32)std::lrint(detail::ClampNormalized(vec.Y(), 0, 1) * 1023.0f) << 10 |
+           (u32)std::lrint(detail::ClampNormalized(vec.Z(), 0, 1) * 1023.0f) << 20 |
+           (u32)std::lrint(detail::ClampNormalized(vec.W(), 0, 1) *    3.0f) << 30;
+  }
+
+  auto Bits() const -> u32 { return bits; }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Vector4 {
+    return Vector4{
+      (float)( bits        & 0x3FF) * (1.0f / 1023.0f),
+      (float)((bits >> 10) & 0x3FF) * (1.0f / 1023.0f),
+      (float)((bits >> 20) & 0x3FF) * (1.0f / 1023.0f),
+      (float)( bits >> 30)          * (1.0f / 3.0f)
+    };
+  }
+
+private:
+  u32 bits = 0; /**< the packed components */
+};
+
+/**
+ * A four-dimensional vector packed into 32 bits with 10 bits for x, y and z and 2 bits for w (A2B10G10R10_SNORM_PACK32).
+ * This is a good fit for tangents, where w only holds the handedness (-1 or +1), which is represented exactly.
+ * The maximum absolute round-trip error is 1 / 1022 (about 9.8e-4) for x, y and z.
+ */
+struct SNorm1010102 {
+  /**
+   * Default constructor. The vector is initialised to (0, 0, 0, 0).
+   */
+  SNorm1010102() {}
+
+  /**
+   * Construct a SNorm1010102 from its packed bits.
+   */
+  explicit SNorm1010102(u32 bits) : bits(bits) {}
+
+  /**
+   * Construct a SNorm1010102 by converting a float vector. Components are clamped to [-1, 1].
+   */
+  explicit SNorm1010102(Vector4 const& vec) {
+    bits = ((u32)std::lrint(detail::ClampNormalized(vec.X(), -1, 1) * 511.0f) & 0x3FF) |
+           ((u32)std::lrint(detail::ClampNormalized(vec.Y(), -1, 1) * 511.0f) & 0x3FF) << 10 |
+           ((u32)std::lrint(detail::ClampNormalized(vec.Z(), -1, 1) * 511.0f) & 0x3FF) << 20 |
+           ((u32)std::lrint(detail::ClampNormalized(vec.W(), -1, 1)         ) & 0x003) << 30;
+  }
+
+  auto Bits() const -> u32 { return bits; }
+
+  /**
+   * Convert this vector to a float vector.
+   * @return the float vector
+   */
+  auto ToFloat() const -> Vector4 {
+    auto x = (float)((s32)(bits << 22) >> 22) * (1.0f / 511.0f);
+    auto y = (float)((s32)(bits << 12) >> 22) * (1.0f / 511.0f);
+    auto z = (float)((s32)(bits <<  2) >> 22) * (1.0f / 511.0f);
+    auto w = (float)((s32) bits        >> 30);
+
+    return Vector4{
+      x > -1.0f ? x : -1.0f,
+      y > -1.0f ? y : -1.0f,
+      z > -1.0f ? z : -1.0f,
+      w > -1.0f ? w : -1.0f
+    };
+  }
+
+private:
+  u32 bits = 0; /**< the packed components */
+};
+
+namespace detail {
+
+#if defined(AURA_MATH_SSE)
+
+inline auto ClampNormalized(__m128 value, __m128 min, __m128 max) -> __m128 {
+  return _mm_max_ps(_mm_min_ps(value, max), min);
+}
+
+inline auto Select(__m128i mask, __m128i a, __m128i b) -> __m128i {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline auto Select(__m128 mask, __m128 a, __m128 b) -> __m128 {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * Convert four floats to half-floats, see {@link #FloatToHalf}.
+ * The result is returned as four sign-extended 32-bit integers, ready for packing with _mm_packs_epi32.
+ */
+inline auto FloatToHalf(__m128 value) -> __m128i {
+  const auto f32_infinity = _mm_set1_epi32(255 << 23);
+  const auto f16_max_minus_one = _mm_set1_epi32(((127 + 16) << 23) - 1);
+  const auto denorm_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+
+  auto bits = _mm_castps_si128(value);
+  auto sign = _mm_and_si128(bits, _mm_set1_epi32((int)0x80000000));
+
+  bits = _mm_xor_si128(bits, sign);
+
+  // The absolute value is never negative as a signed integer, so the signed compares are fine.
+  auto is_inf_or_nan = _mm_cmpgt_epi32(bits, f16_max_minus_one);
+  auto is_nan = _mm_cmpgt_epi32(bits, f32_infinity);
+  auto is_subnormal = _mm_cmplt_epi32(bits, _mm_set1_epi32(113 << 23));
+
+  auto inf_or_nan = Select(is_nan, _mm_set1_epi32(0x7E00), _mm_set1_epi32(0x7C00));
+  auto subnormal = _mm_sub_epi32(
+    _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), _mm_castsi128_ps(denorm_magic))), denorm_magic);
+
+  auto mantissa_odd = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+  auto normal = _mm_add_epi32(bits, _mm_set1_epi32((int)(((u32)(15 - 127) << 23) + 0xFFF)));
+  normal = _mm_srli_epi32(_mm_add_epi32(normal, mantissa_odd), 13);
+
+  auto result = Select(is_inf_or_nan, inf_or_nan, Select(is_subnormal, subnormal, normal));
+  result = _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+
+  return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+}
+
+/**
+ * Convert four half-floats (zero-extended to 32-bit) to floats, see {@link #HalfToFloat}.
+ */
+inline auto HalfToFloat(__m128i half) -> __m128 {
+  const auto shifted_exponent = _mm_set1_epi32(0x7C00 << 13);
+  const auto magic = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+
+  auto bits = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x7FFF)), 13);
+  auto exponent = _mm_and_si128(bits, shifted_exponent);
+
+  bits = _mm_add_epi32(bits, _mm_set1_epi32((127 - 15) << 23));
+
+  auto is_inf_or_nan = _mm_cmpeq_epi32(exponent, shifted_exponent);
+  auto is_subnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+
+  auto inf_or_nan = _mm_add_epi32(bits, _mm_set1_epi32((128 - 16) << 23));
+  auto subnormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))), magic));
+
+  bits = Select(is_inf_or_nan, inf_or_nan, Select(is_subnormal, subnormal, bits));
+  bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16));
+
+  return _mm_castsi128_ps(bits);
+}
+
+/**
+ * Convert four floats to signed normalized integers with `scale` being the largest integer.
+ */
+inline auto FloatToSNorm(__m128 value, __m128 scale) -> __m128i {
+  return _mm_cvtps_epi32(_mm_mul_ps(ClampNormalized(value, _mm_set1_ps(-1), _mm_set1_ps(1)), scale));
+}
+
+/**
+ * Convert four signed normalized integers to floats with `scale` being the reciprocal of the largest integer.
+ */
+inline auto SNormToFloat(__m128i value, __m128 scale) -> __m128 {
+  return _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(value), scale), _mm_set1_ps(-1));
+}
+
+/**
+ * Pack two sets of four unsigned 16-bit integers (in 32-bit lanes) into eight 16-bit integers without saturation.
+ */
+inline auto PackU16(__m128i lo, __m128i hi) -> __m128i {
+  lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+  hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+  return _mm_packs_epi32(lo, hi);
+}
+
+#endif
+
+/**
+ * Shared implementation of the component-wise batch conversions, which process eight components per iteration.
+ *
+ * @tparam In        the input component type
+ * @tparam Out       the output component type
+ * @tparam Scalar    functor that converts a single component
+ * @tparam Simd      functor that converts eight components, loaded from and stored to unaligned memory
+ */
+template<typename In, typename Out, typename Scalar, typename Simd>
+void ConvertComponents(ArrayView<In const> src, ArrayView<Out> dst, Scalar scalar, Simd simd) {
+  const auto count = src.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  for (; i + 8 <= count; i += 8) {
+    simd(&src[i], &dst[i]);
+  }
+#else
+  (void)simd;
+#endif
+
+  for (; i < count; i++) {
+    dst[i] = scalar(src[i]);
+  }
+}
+
+} // namespace Aura::detail
+
+/**
+ * Convert a stream of floats to half-floats, see {@link #FloatToHalf}.
+ * Vector streams (i.e. Vector3 to Vector3h) can be converted by viewing them as streams of components.
+ *
+ * @param src the input floats
+ * @param dst receives the half-floats, must hold at least as many elements as `src`
+ */
+inline void PackHalf(ArrayView<float const> src, ArrayView<u16> dst) {
+  detail::ConvertComponents(src, dst, FloatToHalf, [](float const* src, u16* dst) {
+#if defined(AURA_MATH_F16C)
+    _mm_storeu_si128((__m128i*)dst, _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT));
+#elif defined(AURA_MATH_SSE)
+    auto lo = detail::FloatToHalf(_mm_loadu_ps(&src[0]));
+    auto hi = detail::FloatToHalf(_mm_loadu_ps(&src[4]));
+
+    _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(lo, hi));
+#else
+    (void)src;
+    (void)dst;
+#endif
+  });
+}
+
+/**
+ * Convert a stream of half-floats to floats, see {@link #HalfToFloat}.
+ *
+ * @param src the input half-floats
+ * @param dst receives the floats, must hold at least as many elements as `src`
+ */
+inline void UnpackHalf(ArrayView<u16 const> src, ArrayView<float> dst) {
+  detail::ConvertComponents(src, dst, HalfToFloat, [](u16 const* src, float* dst) {
+#if defined(AURA_MATH_F16C)
+    _mm256_storeu_ps(dst, _mm256_cvtph_ps(_mm_loadu_si128((__m128i const*)src)));
+#elif defined(AURA_MATH_SSE)
+    auto half = _mm_loadu_si128((__m128i const*)src);
+
+    _mm_storeu_ps(&dst[0], detail::HalfToFloat(_mm_unpacklo_epi16(half, _mm_setzero_si128())));
+    _mm_storeu_ps(&dst[4], detail::HalfToFloat(_mm_unpackhi_epi16(half, _mm_setzero_si128())));
+#else
+    (void)src;
+    (void)dst;
+#endif
+  });
+}
+
+/**
+ * Convert a stream of floats to signed normalized 16-bit integers, see {@link #FloatToSNorm16}.
+ *
+ * @param src the input floats
+ * @param dst receives the signed normalized integers, must hold at least as many elements as `src`
+ */
+inline void PackSNorm16(ArrayView<float const> src, ArrayView<s16> dst) {
+  detail::ConvertComponents(src, dst, FloatToSNorm16, [](float const* src, s16* dst) {
+#if defined(AURA_MATH_SSE)
+    const auto scale = _mm_set1_ps(32767.0f);
+
+    auto lo = detail::FloatToSNorm(_mm_loadu_ps(&src[0]), scale);
+    auto hi = detail::FloatToSNorm(_mm_loadu_ps(&src[4]), scale);
+
+    _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(lo, hi));
+#else
+    (void)src;
+    (void)dst;
+#endif
+  });
+}
+
+/**
+ * Convert a stream of signed normalized 16-bit integers to floats, see {@link #SNorm16ToFloat}.
+ *
+ * @param src the input signed normalized integers
+ * @param dst receives the floats, must hold at least as many elements as `src`
+ */
+inline void UnpackSNorm16(ArrayView<s16 const> src, ArrayView<float> dst) {
+  detail::ConvertComponents(src, dst, SNorm16ToFloat, [](s16 const* src, float* dst) {
+#if defined(AURA_MATH_SSE)
+    const auto scale = _mm_set1_ps(1.0f / 32767.0f);
+
+    auto value = _mm_loadu_si128((__m128i const*)src);
+    auto lo = _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+    auto hi = _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+
+    _mm_storeu_ps(&dst[0], detail::SNormToFloat(lo, scale));
+    _mm_storeu_ps(&dst[4], detail::SNormToFloat(hi, scale));
+#else
+    (void)src;
+    (void)dst;
+#endif
+  });
+}
+
+/**
+ * Convert a stream of floats to unsigned normalized 16-bit integers, see {@link #FloatToUNorm16}.
+ *
+ * @param src the input floats
+ * @param dst receives the unsigned normalized integers, must hold at least as many elements as `src`
+ */
+inline void PackUNorm16(ArrayView<float const> src, ArrayView<u16> dst) {
+  detail::ConvertComponents(src, dst, FloatToUNorm16, [](float const* src, u16* dst) {
+#if defined(AURA_MATH_SSE)
+    const auto zero = _mm_setzero_ps();
+    const auto one = _mm_set1_ps(1);
+    const auto scale = _mm_set1_ps(65535.0f);
+
+    auto lo = _mm_cvtps_epi32(_mm_mul_ps(detail::ClampNormalized(_mm_loadu_ps(&src[0]), zero, one), scale));
+    auto hi = _mm_cvtps_epi32(_mm_mul_ps(detail::ClampNormalized(_mm_loadu_ps(&src[4]), zero, one), scale));
+
+    _mm_storeu_si128((__m128i*)dst, detail::PackU16(lo, hi));
+#else
+    (void)src;
+    (void)dst;
+#endif
+  });
+}
+
+/**
+ * Convert a stream of unsigned normalized 16-bit integers to floats, see {@link #UNorm16ToFloat}.
+ *
+ * @param src the input unsigned normalized integers
+ * @param dst receives the floats, must hold at least as many elements as `src`
+ */
+inline void UnpackUNorm16(ArrayView<u16 const> src, ArrayView<float> dst) {
+  detail::ConvertComponents(src, dst, UNorm16ToFloat, [](u16 const* src, float* dst) {
+#if defined(AURA_MATH_SSE)
+    const auto scale = _mm_set1_ps(1.0f / 65535.0f);
+
+    auto value = _mm_loadu_si128((__m128i const*)src);
+    auto lo = _mm_unpacklo_epi16(value, _mm_setzero_si128());
+    auto hi = _mm_unpackhi_epi16(value, _mm_setzero_si128());
+
+    _mm_storeu_ps(&dst[0], _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(&dst[4], _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+#else
+    (void)src;
+    (void)dst;
+#endif
+  });
+}
+
+/**
+ * Encode a stream of unit vectors (i.e. the normal attribute of a vertex buffer) with the octahedral mapping.
+ *
+ * @param normals the input unit vectors
+ * @param encoded receives the encoded unit vectors, must hold at least as many elements as `normals`
+ */
+inline void PackOctahedral(StridedArrayView<Vector3 const> normals, ArrayView<OctahedralNormal> encoded) {
+  const auto count = normals.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto one = _mm_set1_ps(1);
+  const auto zero = _mm_setzero_ps();
+  const auto sign_mask = _mm_set1_ps(-0.0f);
+  const auto scale = _mm_set1_ps(32767.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto x = detail::LoadPoint(normals, i + 0);
+    auto y = detail::LoadPoint(normals, i + 1);
+    auto z = detail::LoadPoint(normals, i + 2);
+    auto w = detail::LoadPoint(normals, i + 3);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    auto abs_x = _mm_andnot_ps(sign_mask, x);
+    auto abs_y = _mm_andnot_ps(sign_mask, y);
+    auto abs_z = _mm_andnot_ps(sign_mask, z);
+    auto rcp = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(abs_x, abs_y), abs_z));
+
+    x = _mm_mul_ps(x, rcp);
+    y = _mm_mul_ps(y, rcp);
+
+    auto folded_x = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, y)), _mm_or_ps(_mm_and_ps(x, sign_mask), one));
+    auto folded_y = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, x)), _mm_or_ps(_mm_and_ps(y, sign_mask), one));
+    auto fold = _mm_cmplt_ps(z, zero);
+
+    auto x_snorm = detail::FloatToSNorm(detail::Select(fold, folded_x, x), scale);
+    auto y_snorm = detail::FloatToSNorm(detail::Select(fold, folded_y, y), scale);
+    auto packed = _mm_or_si128(_mm_and_si128(x_snorm, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(y_snorm, 16));
+
+    _mm_storeu_si128((__m128i*)&encoded[i], packed);
+  }
+#endif
+
+  for (; i < count; i++) {
+    encoded[i] = OctahedralNormal{normals[i]};
+  }
+}
+
+/**
+ * Decode a stream of octahedral-encoded unit vectors.
+ *
+ * @param encoded the encoded unit vectors
+ * @param normals receives the normalised unit vectors, must hold at least as many elements as `encoded`
+ */
+inline void UnpackOctahedral(ArrayView<OctahedralNormal const> encoded, StridedArrayView<Vector3> normals) {
+  const auto count = encoded.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto one = _mm_set1_ps(1);
+  const auto zero = _mm_setzero_ps();
+  const auto sign_mask = _mm_set1_ps(-0.0f);
+  const auto scale = _mm_set1_ps(1.0f / 32767.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto packed = _mm_loadu_si128((__m128i const*)&encoded[i]);
+
+    auto x = detail::SNormToFloat(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16), scale);
+    auto y = detail::SNormToFloat(_mm_srai_epi32(packed, 16), scale);
+    auto z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, x)), _mm_andnot_ps(sign_mask, y));
+    auto t = _mm_max_ps(_mm_xor_ps(z, sign_mask), zero);
+    auto neg_t = _mm_xor_ps(t, sign_mask);
+
+    x = _mm_add_ps(x, detail::Select(_mm_cmpge_ps(x, zero), neg_t, t));
+    y = _mm_add_ps(y, detail::Select(_mm_cmpge_ps(y, zero), neg_t, t));
+
+    auto length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    auto rcp = _mm_div_ps(one, _mm_sqrt_ps(length2));
+
+    x = _mm_mul_ps(x, rcp);
+    y = _mm_mul_ps(y, rcp);
+    z = _mm_mul_ps(z, rcp);
+
+    auto w = zero;
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    detail::StorePoint(normals, i + 0, x);
+    detail::StorePoint(normals, i + 1, y);
+    detail::StorePoint(normals, i + 2, z);
+    detail::StorePoint(normals, i + 3, w);
+  }
+#endif
+
+  for (; i < count; i++) {
+    normals[i] = encoded[i].ToFloat();
+  }
+}
+
+/**
+ * Pack a stream of float vectors into the 10:10:10:2 unsigned normalized format.
+ *
+ * @param src the input vectors
+ * @param dst receives the packed vectors, must hold at least as many elements as `src`
+ */
+inline void PackUNorm1010102(ArrayView<Vector4 const> src, ArrayView<UNorm1010102> dst) {
+  const auto count = src.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto zero = _mm_setzero_ps();
+  const auto one = _mm_set1_ps(1);
+  const auto scale_xyz = _mm_set1_ps(1023.0f);
+  const auto scale_w = _mm_set1_ps(3.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto x = src[i + 0].ToSSE();
+    auto y = src[i + 1].ToSSE();
+    auto z = src[i + 2].ToSSE();
+    auto w = src[i + 3].ToSSE();
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    auto packed = _mm_cvtps_epi32(_mm_mul_ps(detail::ClampNormalized(x, zero, one), scale_xyz));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(detail::ClampNormalized(y, zero, one), scale_xyz)), 10));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(detail::ClampNormalized(z, zero, one), scale_xyz)), 20));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(detail::ClampNormalized(w, zero, one), scale_w)), 30));
+
+    _mm_storeu_si128((__m128i*)&dst[i], packed);
+  }
+#endif
+
+  for (; i < count; i++) {
+    dst[i] = UNorm1010102{src[i]};
+  }
+}
+
+/**
+ * Unpack a stream of vectors in the 10:10:10:2 unsigned normalized format.
+ *
+ * @param src the input packed vectors
+ * @param dst receives the float vectors, must hold at least as many elements as `src`
+ */
+inline void UnpackUNorm1010102(ArrayView<UNorm1010102 const> src, ArrayView<Vector4> dst) {
+  const auto count = src.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto mask = _mm_set1_epi32(0x3FF);
+  const auto scale_xyz = _mm_set1_ps(1.0f / 1023.0f);
+  const auto scale_w = _mm_set1_ps(1.0f / 3.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto packed = _mm_loadu_si128((__m128i const*)&src[i]);
+
+    auto x = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, mask)), scale_xyz);
+    auto y = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 10), mask)), scale_xyz);
+    auto z = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 20), mask)), scale_xyz);
+    auto w = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(packed, 30)), scale_w);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    dst[i + 0] = Vector4::FromSSE(x);
+    dst[i + 1] = Vector4::FromSSE(y);
+    dst[i + 2] = Vector4::FromSSE(z);
+    dst[i + 3] = Vector4::FromSSE(w);
+  }
+#endif
+
+  for (; i < count; i++) {
+    dst[i] = src[i].ToFloat();
+  }
+}
+
+/**
+ * Pack a stream of float vectors into the 10:10:10:2 signed normalized format.
+ *
+ * @param src the input vectors
+ * @param dst receives the packed vectors, must hold at least as many elements as `src`
+ */
+inline void PackSNorm1010102(ArrayView<Vector4 const> src, ArrayView<SNorm1010102> dst) {
+  const auto count = src.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto mask = _mm_set1_epi32(0x3FF);
+  const auto scale_xyz = _mm_set1_ps(511.0f);
+  const auto scale_w = _mm_set1_ps(1.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto x = src[i + 0].ToSSE();
+    auto y = src[i + 1].ToSSE();
+    auto z = src[i + 2].ToSSE();
+    auto w = src[i + 3].ToSSE();
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    auto packed = _mm_and_si128(detail::FloatToSNorm(x, scale_xyz), mask);
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(detail::FloatToSNorm(y, scale_xyz), mask), 10));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(detail::FloatToSNorm(z, scale_xyz), mask), 20));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(detail::FloatToSNorm(w, scale_w), 30));
+
+    _mm_storeu_si128((__m128i*)&dst[i], packed);
+  }
+#endif
+
+  for (; i < count; i++) {
+    dst[i] = SNorm1010102{src[i]};
+  }
+}
+
+/**
+ * Unpack a stream of vectors in the 10:10:10:2 signed normalized format.
+ *
+ * @param src the input packed vectors
+ * @param dst receives the float vectors, must hold at least as many elements as `src`
+ */
+inline void UnpackSNorm1010102(ArrayView<SNorm1010102 const> src, ArrayView<Vector4> dst) {
+  const auto count = src.size();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto scale_xyz = _mm_set1_ps(1.0f / 511.0f);
+  const auto scale_w = _mm_set1_ps(1.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto packed = _mm_loadu_si128((__m128i const*)&src[i]);
+
+    auto x = detail::SNormToFloat(_mm_srai_epi32(_mm_slli_epi32(packed, 22), 22), scale_xyz);
+    auto y = detail::SNormToFloat(_mm_srai_epi32(_mm_slli_epi32(packed, 12), 22), scale_xyz);
+    auto z = detail::SNormToFloat(_mm_srai_epi32(_mm_slli_epi32(packed,  2), 22), scale_xyz);
+    auto w = detail::SNormToFloat(_mm_srai_epi32(packed, 30), scale_w);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    dst[i + 0] = Vector4::FromSSE(x);
+    dst[i + 1] = Vector4::FromSSE(y);
+    dst[i + 2] = Vector4::FromSSE(z);
+    dst[i + 3] = Vector4::FromSSE(w);
+  }
+#endif
+
+  for (; i < count; i++) {
+    dst[i] = src[i].ToFloat();
+  }
+}
+
+} // namespace Aura
@@ -0,0 +1,471 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/matrix4.hpp>
+#include <aurora/math/quaternion.hpp>
+#include <aurora/math/simd.hpp>
+#include <aurora/array_view.hpp>
+#include <aurora/integer.hpp>
+#include <cmath>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * A list of quaternions stored as a structure of arrays.
+ * Each of the four components is stored in its own contiguous array,
+ * which allows the batch operations below to process four quaternions at once using SIMD.
+ */
+struct QuaternionArray {
+  /**
+   * Get the number of quaternions in this array.
+   * @return the number of quaternions
+   */
+  auto Size() const -> size_t {
+    return w.size();
+  }
+
+  /**
+   * Reserve memory for a number of quaternions.
+   *
+   * @param capacity the number of quaternions
+   */
+  void Reserve(size_t capacity) {
+    w.reserve(capacity);
+    x.reserve(capacity);
+    y.reserve(capacity);
+    z.reserve(capacity);
+  }
+
+  /**
+   * Resize this array. New quaternions are initialised to (1 0 0 0).
+   *
+   * @param size the new number of quaternions
+   */
+  void Resize(size_t size) {
+    w.resize(size, 1);
+    x.resize(size, 0);
+    y.resize(size, 0);
+    z.resize(size, 0);
+  }
+
+  /**
+   * Remove all quaternions from this array.
+   */
+  void Clear() {
+    w.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+
+  /**
+   * Append a quaternion to the end of this array.
+   *
+   * @param quat the quaternion
+   */
+  void Push(Quaternion const& quat) {
+    w.push_back(quat.W());
+    x.push_back(quat.X());
+    y.push_back(quat.Y());
+    z.push_back(quat.Z());
+  }
+
+  /**
+   * Replace the quaternion at an index.
+   * Out-of-bounds access is undefined behaviour.
+   *
+   * @param i    the index
+   * @param quat the quaternion
+   */
+  void Set(size_t i, Quaternion const& quat) {
+    w[i] = quat.W();
+    x[i] = quat.X();
+    y[i] = quat.Y();
+    z[i] = quat.Z();
+  }
+
+  /**
+   * Read the quaternion at an index.
+   * Out-of-bounds access is undefined behaviour.
+   *
+   * @param i the index
+   * @return the quaternion
+   */
+  auto Get(size_t i) const -> Quaternion {
+    return Quaternion{w[i], x[i], y[i], z[i]};
+  }
+
+  auto W() -> float* { return w.data(); }
+  auto X() -> float* { return x.data(); }
+  auto Y() -> float* { return y.data(); }
+  auto Z() -> float* { return z.data(); }
+
+  auto W() const -> float const* { return w.data(); }
+  auto X() const -> float const* { return x.data(); }
+  auto Y() const -> float const* { return y.data(); }
+  auto Z() const -> float const* { return z.data(); }
+
+private:
+  std::vector<float> w;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+};
+
+namespace detail {
+
+/**
+ * Coefficients for the polynomial SLERP approximation by David Eberly,
+ * see "A Fast and Accurate Algorithm for Computing SLERP" (2011).
+ * The eight-term approximation stays within 3e-5 of the exact result for interpolation factors between `0` and `1`.
+ */
+struct SLerpCoefficients {
+  static constexpr float k_mu = 1.85298109240830f;
+
+  static constexpr float u[8] {
+    1.0f / (1 *  3), 1.0f / (2 *  5), 1.0f / (3 *  7), 1.0f / (4 *  9),
+    1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), k_mu / (8 * 17)
+  };
+
+  static constexpr float v[8] {
+    1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+    5.0f / 11, 6.0f / 13, 7.0f / 15, k_mu * 8 / 17
+  };
+};
+
+/**
+ * Calculate the factors `c0` and `c1` so that `c0 * q0 + c1 * q1` is the spherical interpolation
+ * between q0 and q1 along the shorter arc.
+ */
+inline void SLerpFactors(float cos_theta, float t, float& c0, float& c1) {
+  auto sign = cos_theta < 0 ? -1.0f : 1.0f;
+  auto x_minus_one = cos_theta * sign - 1;
+  auto d = 1 - t;
+  auto t2 = t * t;
+  auto d2 = d * d;
+
+  auto poly_t = 1.0f;
+  auto poly_d = 1.0f;
+
+  for (int i = 7; i >= 0; i--) {
+    poly_t = 1 + (SLerpCoefficients::u[i] * t2 - SLerpCoefficients::v[i]) * x_minus_one * poly_t;
+    poly_d = 1 + (SLerpCoefficients::u[i] * d2 - SLerpCoefficients::v[i]) * x_minus_one * poly_d;
+  }
+
+  c0 = d * poly_d;
+  c1 = t * poly_t * sign;
+}
+
+enum class QuaternionBlend {
+  NLerp,
+  SLerp
+};
+
+template<QuaternionBlend blend>
+void BlendQuaternions(
+  QuaternionArray const& q0,
+  QuaternionArray const& q1,
+  float const* factors,
+  size_t factor_stride,
+  QuaternionArray& result
+) {
+  const auto count = q0.Size();
+
+  result.Resize(count);
+
+  auto w0 = q0.W(), x0 = q0.X(), y0 = q0.Y(), z0 = q0.Z();
+  auto w1 = q1.W(), x1 = q1.X(), y1 = q1.Y(), z1 = q1.Z();
+  auto w2 = result.W(), x2 = result.X(), y2 = result.Y(), z2 = result.Z();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto one = _mm_set1_ps(1);
+  const auto sign_mask = _mm_set1_ps(-0.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    auto qw0 = _mm_loadu_ps(&w0[i]);
+    auto qx0 = _mm_loadu_ps(&x0[i]);
+    auto qy0 = _mm_loadu_ps(&y0[i]);
+    auto qz0 = _mm_loadu_ps(&z0[i]);
+    auto qw1 = _mm_loadu_ps(&w1[i]);
+    auto qx1 = _mm_loadu_ps(&x1[i]);
+    auto qy1 = _mm_loadu_ps(&y1[i]);
+    auto qz1 = _mm_loadu_ps(&z1[i]);
+    auto t = factor_stride == 0 ? _mm_set1_ps(factors[0]) : _mm_loadu_ps(&factors[i]);
+
+    auto cos_theta = _mm_mul_ps(qw0, qw1);
+    cos_theta = _mm_add_ps(cos_theta, _mm_mul_ps(qx0, qx1));
+    cos_theta = _mm_add_ps(cos_theta, _mm_mul_ps(qy0, qy1));
+    cos_theta = _mm_add_ps(cos_theta, _mm_mul_ps(qz0, qz1));
+
+    auto sign = _mm_and_ps(cos_theta, sign_mask);
+    __m128 c0, c1;
+
+    if constexpr (blend == QuaternionBlend::NLerp) {
+      c0 = _mm_sub_ps(one, t);
+      c1 = _mm_xor_ps(t, sign);
+    } else {
+      auto x_minus_one = _mm_sub_ps(_mm_xor_ps(cos_theta, sign), one);
+      auto d = _mm_sub_ps(one, t);
+      auto t2 = _mm_mul_ps(t, t);
+      auto d2 = _mm_mul_ps(d, d);
+
+      auto poly_t = one;
+      auto poly_d = one;
+
+      for (int j = 7; j >= 0; j--) {
+        auto u = _mm_set1_ps(SLerpCoefficients::u[j]);
+        auto v = _mm_set1_ps(SLerpCoefficients::v[j]);
+
+        poly_t = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, t2), v), x_minus_one), poly_t));
+        poly_d = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, d2), v), x_minus_one), poly_d));
+      }
+
+      c0 = _mm_mul_ps(d, poly_d);
+      c1 = _mm_xor_ps(_mm_mul_ps(t, poly_t), sign);
+    }
+
+    auto qw2 = _mm_add_ps(_mm_mul_ps(c0, qw0), _mm_mul_ps(c1, qw1));
+    auto qx2 = _mm_add_ps(_mm_mul_ps(c0, qx0), _mm_mul_ps(c1, qx1));
+    auto qy2 = _mm_add_ps(_mm_mul_ps(c0, qy0), _mm_mul_ps(c1, qy1));
+    auto qz2 = _mm_add_ps(_mm_mul_ps(c0, qz0), _mm_mul_ps(c1, qz1));
+
+    if constexpr (blend == QuaternionBlend::NLerp) {
+      auto length2 = _mm_mul_ps(qw2, qw2);
+      length2 = _mm_add_ps(length2, _mm_mul_ps(qx2, qx2));
+      length2 = _mm_add_ps(length2, _mm_mul_ps(qy2, qy2));
+      length2 = _mm_add_ps(length2, _mm_mul_ps(qz2, qz2));
+
+      auto scale = _mm_div_ps(one, _mm_sqrt_ps(length2));
+
+      qw2 = _mm_mul_ps(qw2, scale);
+      qx2 = _mm_mul_ps(qx2, scale);
+      qy2 = _mm_mul_ps(qy2, scale);
+      qz2 = _mm_mul_ps(qz2, scale);
+    }
+
+    _mm_storeu_ps(&w2[i], qw2);
+    _mm_storeu_ps(&x2[i], qx2);
+    _mm_storeu_ps(&y2[i], qy2);
+    _mm_storeu_ps(&z2[i], qz2);
+  }
+#endif
+
+  for (; i < count; i++) {
+    auto t = factors[i * factor_stride];
+    auto cos_theta = w0[i] * w1[i] + x0[i] * x1[i] + y0[i] * y1[i] + z0[i] * z1[i];
+
+    float c0, c1;
+
+    if constexpr (blend == QuaternionBlend::NLerp) {
+      c0 = 1 - t;
+      c1 = cos_theta < 0 ? -t : t;
+    } else {
+      SLerpFactors(cos_theta, t, c0, c1);
+    }
+
+    auto quat = Aura::Quaternion{
+      c0 * w0[i] + c1 * w1[i],
+      c0 * x0[i] + c1 * x1[i],
+      c0 * y0[i] + c1 * y1[i],
+      c0 * z0[i] + c1 * z1[i]
+    };
+
+    if constexpr (blend == QuaternionBlend::NLerp) {
+      quat *= 1 / std::sqrt(quat.LengthSquared());
+    }
+
+    w2[i] = quat.W();
+    x2[i] = quat.X();
+    y2[i] = quat.Y();
+    z2[i] = quat.Z();
+  }
+}
+
+} // namespace Aura::detail
+
+/**
+ * Calculate the Hamilton product of each pair of quaternions.
+ * The result is bit-identical to {@link #Quaternion::operator*}. `result` may alias `lhs` or `rhs`.
+ *
+ * @param lhs    the left-hand side quaternions
+ * @param rhs    the right-hand side quaternions, must hold at least as many quaternions as `lhs`
+ * @param result receives the result quaternions, will be resized to the size of `lhs`
+ */
+inline void MultiplyQuaternions(QuaternionArray const& lhs, QuaternionArray const& rhs, QuaternionArray& result) {
+  const auto count = lhs.Size();
+
+  result.Resize(count);
+
+  auto w0 = lhs.W(), x0 = lhs.X(), y0 = lhs.Y(), z0 = lhs.Z();
+  auto w1 = rhs.W(), x1 = rhs.X(), y1 = rhs.Y(), z1 = rhs.Z();
+  auto w2 = result.W(), x2 = result.X(), y2 = result.Y(), z2 = result.Z();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  for (; i + 4 <= count; i += 4) {
+    auto lw = _mm_loadu_ps(&w0[i]);
+    auto lx = _mm_loadu_ps(&x0[i]);
+    auto ly = _mm_loadu_ps(&y0[i]);
+    auto lz = _mm_loadu_ps(&z0[i]);
+    auto rw = _mm_loadu_ps(&w1[i]);
+    auto rx = _mm_loadu_ps(&x1[i]);
+    auto ry = _mm_loadu_ps(&y1[i]);
+    auto rz = _mm_loadu_ps(&z1[i]);
+
+    auto w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(lw, rw), _mm_mul_ps(lx, rx)), _mm_mul_ps(ly, ry)), _mm_mul_ps(lz, rz));
+    auto x = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(lx, rw), _mm_mul_ps(lw, rx)), _mm_mul_ps(lz, ry)), _mm_mul_ps(ly, rz));
+    auto y = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ly, rw), _mm_mul_ps(lz, rx)), _mm_mul_ps(lw, ry)), _mm_mul_ps(lx, rz));
+    auto z = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(lz, rw), _mm_mul_ps(ly, rx)), _mm_mul_ps(lx, ry)), _mm_mul_ps(lw, rz));
+
+    _mm_storeu_ps(&w2[i], w);
+    _mm_storeu_ps(&x2[i], x);
+    _mm_storeu_ps(&y2[i], y);
+    _mm_storeu_ps(&z2[i], z);
+  }
+#endif
+
+  for (; i < count; i++) {
+    auto quat = Quaternion{w0[i], x0[i], y0[i], z0[i]} * Quaternion{w1[i], x1[i], y1[i], z1[i]};
+
+    w2[i] = quat.W();
+    x2[i] = quat.X();
+    y2[i] = quat.Y();
+    z2[i] = quat.Z();
+  }
+}
+
+/**
+ * Perform a normalised linear interpolation between each pair of quaternions with a common factor between `0` and `1`.
+ * Unlike {@link #Quaternion::NLerp} this interpolates along the shorter arc, which is what animation blending expects.
+ *
+ * @param q0     the quaternions at `factor = 0`
+ * @param q1     the quaternions at `factor = 1`, must hold at least as many quaternions as `q0`
+ * @param t      the interpolation factor
+ * @param result receives the interpolated quaternions, will be resized to the size of `q0`
+ */
+inline void NLerpQuaternions(QuaternionArray const& q0, QuaternionArray const& q1, float t, QuaternionArray& result) {
+  detail::BlendQuaternions<detail::QuaternionBlend::NLerp>(q0, q1, &t, 0, result);
+}
+
+/**
+ * Perform a normalised linear interpolation between each pair of quaternions with per-quaternion factors.
+ *
+ * @param q0     the quaternions at `factor = 0`
+ * @param q1     the quaternions at `factor = 1`, must hold at least as many quaternions as `q0`
+ * @param t      the interpolation factors, must hold at least as many factors as `q0`
+ * @param result receives the interpolated quaternions, will be resized to the size of `q0`
+ */
+inline void NLerpQuaternions(QuaternionArray const& q0, QuaternionArray const& q1, ArrayView<float const> t, QuaternionArray& result) {
+  detail::BlendQuaternions<detail::QuaternionBlend::NLerp>(q0, q1, t.data(), 1, result);
+}
+
+/**
+ * Perform a spherical interpolation between each pair of quaternions with a common factor between `0` and `1`.
+ * Unlike {@link #Quaternion::SLerp} this interpolates along the shorter arc, which is what animation blending expects.
+ * It uses a polynomial approximation instead of trigonometric functions, see {@link #detail::SLerpCoefficients}.
+ *
+ * @param q0     the quaternions at `factor = 0`
+ * @param q1     the quaternions at `factor = 1`, must hold at least as many quaternions as `q0`
+ * @param t      the interpolation factor
+ * @param result receives the interpolated quaternions, will be resized to the size of `q0`
+ */
+inline void SLerpQuaternions(QuaternionArray const& q0, QuaternionArray const& q1, float t, QuaternionArray& result) {
+  detail::BlendQuaternions<detail::QuaternionBlend::SLerp>(q0, q1, &t, 0, result);
+}
+
+/**
+ * Perform a spherical interpolation between each pair of quaternions with per-quaternion factors.
+ *
+ * @param q0     the quaternions at `factor = 0`
+ * @param q1     the quaternions at `factor = 1`, must hold at least as many quaternions as `q0`
+ * @param t      the interpolation factors, must hold at least as many factors as `q0`
+ * @param result receives the interpolated quaternions, will be resized to the size of `q0`
+ */
+inline void SLerpQuaternions(QuaternionArray const& q0, QuaternionArray const& q1, ArrayView<float const> t, QuaternionArray& result) {
+  detail::BlendQuaternions<detail::QuaternionBlend::SLerp>(q0, q1, t.data(), 1, result);
+}
+
+/**
+ * Create the 4x4 rotation matrix for each quaternion.
+ * The result is bit-identical to {@link #Quaternion::ToRotationMatrix}.
+ *
+ * @param quaternions the pure, normalised rotation quaternions
+ * @param matrices    receives the rotation matrices, must hold at least as many matrices as `quaternions`
+ */
+inline void QuaternionsToRotationMatrices(QuaternionArray const& quaternions, ArrayView<Matrix4> matrices) {
+  const auto count = quaternions.Size();
+
+  auto qw = quaternions.W();
+  auto qx = quaternions.X();
+  auto qy = quaternions.Y();
+  auto qz = quaternions.Z();
+
+  size_t i = 0;
+
+#if defined(AURA_MATH_SSE)
+  const auto one = _mm_set1_ps(1);
+  const auto two = _mm_set1_ps(2);
+  const auto w_axis = Vector4{0, 0, 0, 1};
+
+  for (; i + 4 <= count; i += 4) {
+    auto w = _mm_loadu_ps(&qw[i]);
+    auto x = _mm_loadu_ps(&qx[i]);
+    auto y = _mm_loadu_ps(&qy[i]);
+    auto z = _mm_loadu_ps(&qz[i]);
+
+    auto wx = _mm_mul_ps(w, x);
+    auto wy = _mm_mul_ps(w, y);
+    auto wz = _mm_mul_ps(w, z);
+    auto xx = _mm_mul_ps(x, x);
+    auto xy = _mm_mul_ps(x, y);
+    auto xz = _mm_mul_ps(x, z);
+    auto yy = _mm_mul_ps(y, y);
+    auto yz = _mm_mul_ps(y, z);
+    auto zz = _mm_mul_ps(z, z);
+
+    // Each group of three vectors holds one basis vector of four matrices, which is transposed to four columns.
+    __m128 axes[3][4] {
+      {
+        _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(zz, yy))),
+        _mm_mul_ps(two, _mm_add_ps(xy, wz)),
+        _mm_mul_ps(two, _mm_sub_ps(xz, wy)),
+        _mm_setzero_ps()
+      }, {
+        _mm_mul_ps(two, _mm_sub_ps(xy, wz)),
+        _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))),
+        _mm_mul_ps(two, _mm_add_ps(yz, wx)),
+        _mm_setzero_ps()
+      }, {
+        _mm_mul_ps(two, _mm_add_ps(xz, wy)),
+        _mm_mul_ps(two, _mm_sub_ps(yz, wx)),
+        _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))),
+        _mm_setzero_ps()
+      }
+    };
+
+    for (auto& axis : axes) {
+      _MM_TRANSPOSE4_PS(axis[0], axis[1], axis[2], axis[3]);
+    }
+
+    for (int j = 0; j < 4; j++) {
+      auto& matrix = matrices[i + j];
+
+      matrix.X() = Vector4::FromSSE(axes[0][j]);
+      matrix.Y() = Vector4::FromSSE(axes[1][j]);
+      matrix.Z() = Vector4::FromSSE(axes[2][j]);
+      matrix.W() = w_axis;
+    }
+  }
+#endif
+
+  for (; i < count; i++) {
+    matrices[i] = Quaternion{qw[i], qx[i], qy[i], qz[i]}.ToRotationMatrix();
+  }
+}
+
+} // namespace Aura
@@ -0,0 +1,145 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <aurora/math/box3.hpp>
+#include <aurora/math/matrix4.hpp>
+#include <aurora/math/triangle.hpp>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+namespace Aura {
+
+/**
+ * A ray defined through an origin and a direction.
+ * Points on the ray are `origin + direction * t` for `t >= 0`.
+ */
+struct Ray {
+  /**
+   * Default constructor. The ray starts at (0, 0, 0) and points along the negative z-Axis.
+   */
+  Ray() {}
+
+  /**
+   * Construct a Ray from an origin and a direction.
+   *
+   * @param origin    the origin
+   * @param direction the direction, which should be normalized for `t` to be the distance from the origin
+   */
+  Ray(Vector3 const& origin, Vector3 const& direction) : origin(origin), direction(direction) {}
+
+  auto Origin() -> Vector3& { return origin; }
+  auto Direction() -> Vector3& { return direction; }
+
+  auto Origin() const -> Vector3 const& { return origin; }
+  auto Direction() const -> Vector3 const& { return direction; }
+
+  /**
+   * Get the point on this ray at a given parameter.
+   *
+   * @param t the ray parameter
+   * @return the point
+   */
+  auto At(float t) const -> Vector3 {
+    return origin + direction * t;
+  }
+
+  /**
+   * Apply a matrix transform on this ray.
+   * The direction is not normalized, so that the ray parameter of a point is the same before and after the transform.
+   *
+   * @param matrix the (affine) matrix transform
+   * @return the transformed ray
+   */
+  auto ApplyMatrix(Matrix4 const& matrix) const -> Ray {
+    auto new_origin = matrix.X().XYZ() * origin.X() +
+                      matrix.Y().XYZ() * origin.Y() +
+                      matrix.Z().XYZ() * origin.Z() + matrix.W().XYZ();
+
+    auto new_direction = matrix.X().XYZ() * direction.X() +
+                         matrix.Y().XYZ() * direction.Y() +
+                         matrix.Z().XYZ() * direction.Z();
+
+    return Ray{new_origin, new_direction};
+  }
+
+  /**
+   * Calculate whether this ray intersects an axis-aligned bounding box ({@link #Box3}) using the slab method.
+   *
+   * @param box   the bounding box
+   * @param t_max the ray parameter after which intersections are ignored
+   * @return true if the ray enters the box between `0` and `t_max`
+   */
+  bool IntersectsBox(Box3 const& box, float t_max = std::numeric_limits<float>::infinity()) const {
+    auto t_min = 0.0f;
+
+    for (int i = 0; i < 3; i++) {
+      auto recip_direction = 1 / direction[i];
+      auto t0 = (box.Min()[i] - origin[i]) * recip_direction;
+      auto t1 = (box.Max()[i] - origin[i]) * recip_direction;
+
+      if (t0 > t1) {
+        std::swap(t0, t1);
+      }
+
+      // Written so that NaNs, which occur if the origin lies on a slab with a zero direction, do not reject the box.
+      t_min = t0 > t_min ? t0 : t_min;
+      t_max = t1 < t_max ? t1 : t_max;
+
+      if (t_min > t_max) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Calculate the intersection of this ray with a {@link #Triangle} using the Möller-Trumbore algorithm.
+   * Both sides of the triangle are considered.
+   *
+   * @param triangle the triangle
+   * @return the ray parameter of the intersection or std::nullopt if the ray misses the triangle
+   */
+  auto IntersectTriangle(Triangle const& triangle) const -> std::optional<float> {
+    auto edge1 = triangle.B() - triangle.A();
+    auto edge2 = triangle.C() - triangle.A();
+    auto p = direction.Cross(edge2);
+    auto determinant = edge1.Dot(p);
+
+    if (determinant == 0) {
+      return std::nullopt;
+    }
+
+    auto recip_determinant = 1 / determinant;
+    auto s = origin - triangle.A();
+    auto u = s.Dot(p) * recip_determinant;
+
+    if (u < 0 || u > 1) {
+      return std::nullopt;
+    }
+
+    auto q = s.Cross(edge1);
+    auto v = direction.Dot(q) * recip_determinant;
+
+    if (v < 0 || u + v > 1) {
+      return std::nullopt;
+    }
+
+    auto t = edge2.Dot(q) * recip_determinant;
+
+    if (t < 0) {
+      return std::nullopt;
+    }
+
+    return t;
+  }
+
+private:
+  Vector3 origin; /**< the origin */
+  Vector3 direction{0, 0, -1}; /**< the direction */
+};
+
+} // namespace Aura
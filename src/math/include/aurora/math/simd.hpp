@@ -0,0 +1,36 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+/**
+ * Compile-time selection of the SIMD instruction set used by Aurora-Math.
+ *
+ * AURA_MATH_SSE is defined when SSE2 is available (always the case on x86-64),
+ * AURA_MATH_AVX is additionally defined when the target supports AVX.
+ * AURA_MATH_F16C is additionally defined when the target supports the F16C half-float conversion instructions.
+ * Define AURA_MATH_NO_SIMD before including any Aurora-Math header to force the scalar fallback.
+ *
+ * The SIMD code paths evaluate the same operations in the same order as the scalar code,
+ * so results are bit-identical as long as the compiler does not contract multiply-add
+ * sequences into FMA instructions (i.e. build with -ffp-contract=off when targeting FMA).
+ */
+
+#if !defined(AURA_MATH_NO_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define AURA_MATH_SSE
+  #endif
+
+  #if defined(AURA_MATH_SSE) && defined(__AVX__)
+    #define AURA_MATH_AVX
+  #endif
+
+  #if defined(AURA_MATH_AVX) && defined(__F16C__)
+    #define AURA_MATH_F16C
+  #endif
+#endif
+
+#if defined(AURA_MATH_AVX)
+  #include <immintrin.h>
+#elif defined(AURA_MATH_SSE)
+  #include <emmintrin.h>
+#endif
@@ -0,0 +1,103 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <aurora/math/box3.hpp>
+#include <aurora/math/matrix4.hpp>
+#include <cmath>
+
+namespace Aura {
+
+/**
+ * A 3D bounding sphere defined through a center point and a radius.
+ */
+struct Sphere {
+  /**
+   * Default constructor. The sphere is initialized to lie at (0, 0, 0) with a radius of zero.
+   */
+  Sphere() {}
+
+  /**
+   * Construct a Sphere from a center point and a radius.
+   *
+   * @param center the center point
+   * @param radius the radius
+   */
+  Sphere(Vector3 const& center, float radius) : center(center), radius(radius) {}
+
+  auto Center() -> Vector3& { return center; }
+  auto Radius() -> float& { return radius; }
+
+  auto Center() const -> Vector3 const& { return center; }
+  auto Radius() const -> float { return radius; }
+
+  /**
+   * Calculate whether this sphere intersects an axis-aligned bounding box ({@link #Box3}),
+   * by comparing the distance from the center to the closest point of the box against the radius.
+   *
+   * @param box the bounding box
+   * @return true if the sphere and the box intersect
+   */
+  bool IntersectsBox(Box3 const& box) const {
+    auto distance2 = 0.0f;
+
+    for (int i = 0; i < 3; i++) {
+      auto delta = center[i] - std::clamp(center[i], box.Min()[i], box.Max()[i]);
+
+      distance2 += delta * delta;
+    }
+
+    return distance2 <= radius * radius;
+  }
+
+  /**
+   * Get the smallest axis-aligned bounding box ({@link #Box3}) that contains this sphere.
+   * @return the bounding box
+   */
+  auto GetBoundingBox() const -> Box3 {
+    auto extent = Vector3{radius, radius, radius};
+
+    return Box3{center - extent, center + extent};
+  }
+
+  /**
+   * Apply a matrix transform on this bounding sphere.
+   * The center is transformed by the matrix and the radius is scaled by an upper bound of how far the matrix stretches
+   * any direction, so that the new sphere still contains the transformed volume if the matrix is non-uniformly scaled
+   * and rotated (for example a rotated child of a non-uniformly scaled parent). The bound is exact if the basis vectors
+   * are orthogonal, which includes rigid transforms.
+   *
+   * @param matrix the (affine) matrix transform
+   * @return the transformed bounding sphere
+   */
+  auto ApplyMatrix(Matrix4 const& matrix) const -> Sphere {
+    auto new_center = matrix.X().XYZ() * center.X() +
+                      matrix.Y().XYZ() * center.Y() +
+                      matrix.Z().XYZ() * center.Z() + matrix.W().XYZ();
+
+    auto x = matrix.X().XYZ();
+    auto y = matrix.Y().XYZ();
+    auto z = matrix.Z().XYZ();
+
+    auto xx = x.Dot(x);
+    auto yy = y.Dot(y);
+    auto zz = z.Dot(z);
+    auto xy = std::abs(x.Dot(y));
+    auto xz = std::abs(x.Dot(z));
+    auto yz = std::abs(y.Dot(z));
+
+    // The largest stretch squared is the largest eigenvalue of the Gram matrix of the basis vectors.
+    // Bound it by the largest row sum of absolute values (Gershgorin) and by the trace, whichever is smaller.
+    auto row_sum_max = std::max(xx + xy + xz, std::max(xy + yy + yz, xz + yz + zz));
+    auto stretch2 = std::min(row_sum_max, xx + yy + zz);
+
+    return Sphere{new_center, radius * std::sqrt(stretch2)};
+  }
+
+private:
+  Vector3 center; /**< the center point */
+  float radius = 0; /**< the radius */
+};
+
+} // namespace Aura
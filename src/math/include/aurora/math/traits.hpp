@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <aurora/integer.hpp>
+
 namespace Aura {
 
 template<typename T>
@@ -33,4 +35,26 @@ struct NumericConstants<double> {
   }
 };
 
+template<>
+struct NumericConstants<s16> {
+  static constexpr auto Zero() -> s16 {
+    return 0;
+  }
+
+  static constexpr auto One() -> s16 {
+    return 1;
+  }
+};
+
+template<>
+struct NumericConstants<u16> {
+  static constexpr auto Zero() -> u16 {
+    return 0;
+  }
+
+  static constexpr auto One() -> u16 {
+    return 1;
+  }
+};
+
 } // namespace Aura
@@ -0,0 +1,181 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <aurora/math/box3.hpp>
+#include <aurora/math/matrix4.hpp>
+#include <cmath>
+
+namespace Aura {
+
+/**
+ * A triangle in 3D space defined through its three vertices.
+ */
+struct Triangle {
+  /**
+   * Default constructor. All vertices are initialized to (0, 0, 0).
+   */
+  Triangle() {}
+
+  /**
+   * Construct a Triangle from three vertices.
+   *
+   * @param a the first vertex
+   * @param b the second vertex
+   * @param c the third vertex
+   */
+  Triangle(Vector3 const& a, Vector3 const& b, Vector3 const& c) : a(a), b(b), c(c) {}
+
+  auto A() -> Vector3& { return a; }
+  auto B() -> Vector3& { return b; }
+  auto C() -> Vector3& { return c; }
+
+  auto A() const -> Vector3 const& { return a; }
+  auto B() const -> Vector3 const& { return b; }
+  auto C() const -> Vector3 const& { return c; }
+
+  /**
+   * Get the smallest axis-aligned bounding box that contains this triangle.
+   * @return the bounding box
+   */
+  auto GetBoundingBox() const -> Box3 {
+    Box3 box;
+
+    for (int i = 0; i < 3; i++) {
+      box.Min()[i] = std::min(a[i], std::min(b[i], c[i]));
+      box.Max()[i] = std::max(a[i], std::max(b[i], c[i]));
+    }
+    return box;
+  }
+
+  /**
+   * Apply a matrix transform on each vertex of this triangle.
+   *
+   * @param matrix the (affine) matrix transform
+   * @return the transformed triangle
+   */
+  auto ApplyMatrix(Matrix4 const& matrix) const -> Triangle {
+    const auto transform = [&](Vector3 const& point) {
+      return matrix.X().XYZ() * point.X() +
+             matrix.Y().XYZ() * point.Y() +
+             matrix.Z().XYZ() * point.Z() + matrix.W().XYZ();
+    };
+
+    return Triangle{transform(a), transform(b), transform(c)};
+  }
+
+  /**
+   * Calculate the point on this triangle that is closest to a given point.
+   * Based on "Real-Time Collision Detection" by Christer Ericson, section 5.1.5.
+   *
+   * @param point the point
+   * @return the closest point on the triangle
+   */
+  auto GetClosestPoint(Vector3 const& point) const -> Vector3 {
+    auto ab = b - a;
+    auto ac = c - a;
+    auto ap = point - a;
+
+    // Check if the point is in the vertex region outside of A.
+    auto d1 = ab.Dot(ap);
+    auto d2 = ac.Dot(ap);
+    if (d1 <= 0 && d2 <= 0) {
+      return a;
+    }
+
+    // Check if the point is in the vertex region outside of B.
+    auto bp = point - b;
+    auto d3 = ab.Dot(bp);
+    auto d4 = ac.Dot(bp);
+    if (d3 >= 0 && d4 <= d3) {
+      return b;
+    }
+
+    // Check if the point is in the edge region of AB.
+    auto vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+      return a + ab * (d1 / (d1 - d3));
+    }
+
+    // Check if the point is in the vertex region outside of C.
+    auto cp = point - c;
+    auto d5 = ab.Dot(cp);
+    auto d6 = ac.Dot(cp);
+    if (d6 >= 0 && d5 <= d6) {
+      return c;
+    }
+
+    // Check if the point is in the edge region of AC.
+    auto vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+      return a + ac * (d2 / (d2 - d6));
+    }
+
+    // Check if the point is in the edge region of BC.
+    auto va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+      return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    // The point is inside the face region.
+    auto denominator = 1 / (va + vb + vc);
+
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+  }
+
+  /**
+   * Calculate whether this triangle intersects an axis-aligned bounding box ({@link #Box3}).
+   * This is a separating axis test of the box axes, the triangle normal and the nine cross products of their edges,
+   * based on "Fast 3D Triangle-Box Overlap Testing" by Tomas Akenine-Möller.
+   *
+   * @param box the bounding box
+   * @return true if the triangle and the box intersect
+   */
+  bool IntersectsBox(Box3 const& box) const {
+    auto center = box.Center();
+    auto extent = box.Extent();
+
+    // Move the box to the origin.
+    Vector3 v[3] {a - center, b - center, c - center};
+    Vector3 edges[3] {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+
+    const auto separated_by = [&](Vector3 const& axis) {
+      auto p0 = v[0].Dot(axis);
+      auto p1 = v[1].Dot(axis);
+      auto p2 = v[2].Dot(axis);
+      auto radius = extent.X() * std::abs(axis.X()) +
+                    extent.Y() * std::abs(axis.Y()) +
+                    extent.Z() * std::abs(axis.Z());
+
+      return std::min(p0, std::min(p1, p2)) > radius || std::max(p0, std::max(p1, p2)) < -radius;
+    };
+
+    // The nine cross products of the box axes and the triangle edges.
+    for (auto& edge : edges) {
+      if (separated_by(Vector3{0, -edge.Z(), edge.Y()}) ||
+          separated_by(Vector3{edge.Z(), 0, -edge.X()}) ||
+          separated_by(Vector3{-edge.Y(), edge.X(), 0})) {
+        return false;
+      }
+    }
+
+    // The box axes, which is equivalent to testing the bounding box of the triangle against the box.
+    for (int i = 0; i < 3; i++) {
+      if (std::min(v[0][i], std::min(v[1][i], v[2][i])) > extent[i] ||
+          std::max(v[0][i], std::max(v[1][i], v[2][i])) < -extent[i]) {
+        return false;
+      }
+    }
+
+    // The triangle normal.
+    return !separated_by(edges[0].Cross(edges[1]));
+  }
+
+private:
+  Vector3 a; /**< the first vertex */
+  Vector3 b; /**< the second vertex */
+  Vector3 c; /**< the third vertex */
+};
+
+} // namespace Aura
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <aurora/integer.hpp>
+#include <aurora/math/simd.hpp>
 #include <aurora/math/traits.hpp>
 #include <cmath>
 
@@ -47,6 +48,22 @@ struct Vector {
     return data[i];
   }
 
+  /**
+   * Get a pointer to the `n` contiguous components of the vector.
+   * @return a pointer to the first component
+   */
+  auto Data() -> T* {
+    return data;
+  }
+
+  /**
+   * Get a pointer to the `n` contiguous components of the vector.
+   * @return a pointer to the first component
+   */
+  auto Data() const -> T const* {
+    return data;
+  }
+
   /**
    * Perform a component-wise summation of this vector with another vector.
    * Store the result in a new vector.
@@ -277,7 +294,7 @@ struct Vector3 : Vector<Derived, T, 3> {
    * @param other the other vector
    * @returm the result vector
    */
-  auto Cross(Vector3 const& other) const -> Vector3 {
+  auto Cross(Derived const& other) const -> Derived {
     return {
       this->data[1] * other[2] - this->data[2] * other[1],
       this->data[2] * other[0] - this->data[0] * other[2],
@@ -366,9 +383,74 @@ struct Vector3 final : detail::Vector3<Vector3, float> {
 
 /**
  * A four-dimensional float vector
+ *
+ * The component-wise arithmetic is implemented with SSE when available (see simd.hpp).
+ * The generic implementation in detail::Vector is the scalar reference.
  */
 struct Vector4 final : detail::Vector4<Vector4, Vector3, float> {
   using detail::Vector4<Vector4, Vector3, float>::Vector4;
+
+#if defined(AURA_MATH_SSE)
+  auto operator+(Vector4 const& other) const -> Vector4 {
+    return FromSSE(_mm_add_ps(ToSSE(), other.ToSSE()));
+  }
+
+  auto operator-(Vector4 const& other) const -> Vector4 {
+    return FromSSE(_mm_sub_ps(ToSSE(), other.ToSSE()));
+  }
+
+  auto operator*(float value) const -> Vector4 {
+    return FromSSE(_mm_mul_ps(ToSSE(), _mm_set1_ps(value)));
+  }
+
+  auto operator/(float value) const -> Vector4 {
+    return FromSSE(_mm_div_ps(ToSSE(), _mm_set1_ps(value)));
+  }
+
+  auto operator+=(Vector4 const& other) -> Vector4& {
+    *this = FromSSE(_mm_add_ps(ToSSE(), other.ToSSE()));
+    return *this;
+  }
+
+  auto operator-=(Vector4 const& other) -> Vector4& {
+    *this = FromSSE(_mm_sub_ps(ToSSE(), other.ToSSE()));
+    return *this;
+  }
+
+  auto operator*=(float value) -> Vector4& {
+    *this = FromSSE(_mm_mul_ps(ToSSE(), _mm_set1_ps(value)));
+    return *this;
+  }
+
+  auto operator/=(float value) -> Vector4& {
+    *this = FromSSE(_mm_div_ps(ToSSE(), _mm_set1_ps(value)));
+    return *this;
+  }
+
+  auto operator-() const -> Vector4 {
+    return FromSSE(_mm_xor_ps(ToSSE(), _mm_set1_ps(-0.0f)));
+  }
+
+  /**
+   * Load the vector into an SSE register.
+   * @return the SSE register
+   */
+  auto ToSSE() const -> __m128 {
+    return _mm_loadu_ps(data);
+  }
+
+  /**
+   * Create a vector from an SSE register.
+   *
+   * @param value the SSE register
+   * @return the vector
+   */
+  static auto FromSSE(__m128 value) -> Vector4 {
+    Vector4 result;
+    _mm_storeu_ps(result.data, value);
+    return result;
+  }
+#endif
 };
 
 } // namespaace Aura
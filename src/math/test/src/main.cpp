@@ -0,0 +1,21 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <fmt/format.h>
+
+#include "test.hpp"
+
+using namespace Aura;
+
+int main() {
+  TestMatrix4();
+  TestQuantized();
+  TestSphere();
+
+  if (g_failure_count != 0) {
+    fmt::print(stderr, "{} check(s) failed\n", g_failure_count);
+    return 1;
+  }
+
+  fmt::print(stderr, "all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,167 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/math/matrix4.hpp>
+#include <aurora/math/quaternion.hpp>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "scalar_reference.hpp"
+#include "test.hpp"
+
+namespace Aura {
+
+static auto Store(Matrix4 const& matrix) -> ScalarReference::Matrix {
+  ScalarReference::Matrix result;
+  for (int i = 0; i < 16; i++) result[i] = matrix[i >> 2][i & 3];
+  return result;
+}
+
+static auto Store(Vector4 const& vector) -> ScalarReference::Vector {
+  return {vector[0], vector[1], vector[2], vector[3]};
+}
+
+template<size_t n>
+static auto BitEqual(std::array<float, n> const& a, std::array<float, n> const& b) -> bool {
+  return std::memcmp(a.data(), b.data(), sizeof(float) * n) == 0;
+}
+
+static auto RandomVector3(float scale = 1) -> Vector3 {
+  return Vector3{RandomFloat(), RandomFloat(), RandomFloat()} * scale;
+}
+
+static auto RandomRotation() -> Matrix4 {
+  auto quat = Quaternion{RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat()};
+  quat.Normalize();
+  return quat.ToRotationMatrix();
+}
+
+/**
+ * Build matrices that exercise the general, affine and rigid code paths,
+ * including edge cases such as signed zeros, huge and tiny scales and singular matrices.
+ */
+static auto CreateMatrices() -> std::vector<Matrix4> {
+  constexpr float k_max = std::numeric_limits<float>::max();
+  constexpr float k_denormal = std::numeric_limits<float>::denorm_min();
+
+  std::vector<Matrix4> matrices{
+    Matrix4{},
+    Matrix4::Translation(0, 0, 0),
+    Matrix4::Translation(-0.0f, 0.0f, -0.0f),
+    Matrix4::Translation(1e30f, -1e30f, 0.5f),
+    Matrix4::Scale(1e-18f, 1e-18f, 1e-18f),
+    Matrix4::Scale(1e18f, 1e18f, 1e18f),
+    Matrix4::Scale(-1, 2, -0.5f),
+    Matrix4::Scale(0, 1, 1),
+    Matrix4::PerspectiveVK(1.0, 16 / 9.0, 0.01, 500.0),
+    Matrix4{{
+      k_max, 0, 0, k_denormal,
+      0, -k_max, 0, -k_denormal,
+      0, 0, 1, 0,
+      0, 0, 0, 1
+    }},
+    Matrix4{{
+      -0.0f, 1, 0, 0,
+      1, -0.0f, 0, 0,
+      0, 0, -0.0f, 1,
+      0, 0, 1, -0.0f
+    }}
+  };
+
+  for (int i = 0; i < 256; i++) {
+    auto scale = RandomFloat(0.01, 100);
+
+    // rigid
+    matrices.push_back(Matrix4::Translation(RandomVector3(100)) * RandomRotation() * Matrix4::Scale(scale, scale, scale));
+
+    // affine
+    matrices.push_back(
+      Matrix4::Translation(RandomVector3(100)) *
+      RandomRotation() *
+      Matrix4::Scale(RandomFloat(0.01, 100), RandomFloat(-100, -0.01), RandomFloat(0.01, 100))
+    );
+
+    // general
+    Matrix4 matrix;
+    for (int j = 0; j < 16; j++) matrix[j >> 2][j & 3] = RandomFloat(-10, 10);
+    matrices.push_back(matrix);
+  }
+
+  return matrices;
+}
+
+static auto CreateVectors() -> std::vector<Vector4> {
+  std::vector<Vector4> vectors{
+    Vector4{0, 0, 0, 0},
+    Vector4{-0.0f, -0.0f, -0.0f, -0.0f},
+    Vector4{0, 0, 0, 1},
+    Vector4{1e30f, -1e30f, 1e-30f, -1e-30f},
+    Vector4{std::numeric_limits<float>::infinity(), 1, 0, -1}
+  };
+
+  for (int i = 0; i < 64; i++) {
+    vectors.push_back(Vector4{RandomFloat(-100, 100), RandomFloat(-100, 100), RandomFloat(-100, 100), RandomFloat(-100, 100)});
+  }
+
+  return vectors;
+}
+
+static void TestVector4(std::vector<Vector4> const& vectors) {
+  static char const* const k_operator_names[] {
+    "+", "-", "* s", "/ s", "unary -", "+=", "-=", "*= s", "/= s"
+  };
+
+  for (auto const& u : vectors) {
+    for (auto const& v : vectors) {
+      auto s = v.X();
+
+      auto add = u; add += v;
+      auto sub = u; sub -= v;
+      auto mul = u; mul *= s;
+      auto div = u; div /= s;
+
+      std::array<ScalarReference::Vector, 9> actual{
+        Store(u + v), Store(u - v), Store(u * s), Store(u / s), Store(-u),
+        Store(add), Store(sub), Store(mul), Store(div)
+      };
+      auto expected = ScalarReference::VectorOperators(Store(u), Store(v), s);
+
+      for (size_t i = 0; i < actual.size(); i++) {
+        Check(BitEqual(actual[i], expected[i]), "Vector4 operator {} differs from the scalar path", k_operator_names[i]);
+      }
+    }
+  }
+}
+
+void TestMatrix4() {
+  auto matrices = CreateMatrices();
+  auto vectors = CreateVectors();
+
+  TestVector4(vectors);
+
+  for (size_t i = 0; i < matrices.size(); i++) {
+    auto& matrix = matrices[i];
+    auto reference = Store(matrix);
+
+    Check(BitEqual(Store(matrix.Inverse()), ScalarReference::Inverse(reference)),
+      "Matrix4::Inverse differs from the scalar path for matrix #{}", i);
+
+    Check(BitEqual(Store(matrix.InverseAffine()), ScalarReference::InverseAffine(reference)),
+      "Matrix4::InverseAffine differs from the scalar path for matrix #{}", i);
+
+    Check(BitEqual(Store(matrix.InverseRigid()), ScalarReference::InverseRigid(reference)),
+      "Matrix4::InverseRigid differs from the scalar path for matrix #{}", i);
+
+    for (size_t j = 0; j < matrices.size(); j += 7) {
+      Check(BitEqual(Store(matrix * matrices[j]), ScalarReference::Multiply(reference, Store(matrices[j]))),
+        "Matrix4 * Matrix4 differs from the scalar path for matrices #{} and #{}", i, j);
+    }
+
+    for (size_t j = 0; j < vectors.size(); j++) {
+      Check(BitEqual(Store(matrix * vectors[j]), ScalarReference::Multiply(reference, Store(vectors[j]))),
+        "Matrix4 * Vector4 differs from the scalar path for matrix #{} and vector #{}", i, j);
+    }
+  }
+}
+
+} // namespace Aura
@@ -0,0 +1,265 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/math/quantized.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "test.hpp"
+
+namespace Aura {
+
+// Absolute error bounds hold up to one float ulp at 1.0, see the documentation of quantized.hpp.
+static constexpr double k_float_rounding = 1.0 / 16777216; // 2^-24
+
+/**
+ * Tracks the largest error of a round trip and checks it against the bound that is documented on the format.
+ */
+struct MaxError {
+  char const* name;
+  double bound;
+  double max_error = 0;
+
+  void Add(double error) {
+    max_error = std::max(max_error, error);
+  }
+
+  void Check() const {
+    Aura::Check(max_error <= bound, "{}: max round-trip error {} exceeds the bound {}", name, max_error, bound);
+  }
+};
+
+template<typename T>
+static auto BitEqual(T const& a, T const& b) -> bool {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// Most inputs are midpoints between two quantized values, which is where the rounding error peaks.
+
+static void TestHalf() {
+  constexpr double k_min_normal = 1.0 / 16384; // 2^-14
+
+  std::vector<float> values;
+
+  for (u32 half = 0; half < 0x7BFF; half++) {
+    auto midpoint = (HalfToFloat((u16)half) + HalfToFloat((u16)(half + 1))) * 0.5f;
+
+    values.push_back(midpoint);
+    values.push_back(-midpoint);
+  }
+
+  for (int i = 0; i < 100000; i++) {
+    values.push_back(std::ldexp(RandomFloat(-1, 1), (int)RandomFloat(-24, 16)));
+  }
+
+  auto scalar_error = MaxError{"half (scalar)", 1.0 / 2048};
+  auto scalar_subnormal_error = MaxError{"half subnormal (scalar)", 1.0 / 33554432}; // 2^-25
+  auto batch_error = MaxError{"half (batch)", 1.0 / 2048};
+  auto batch_subnormal_error = MaxError{"half subnormal (batch)", 1.0 / 33554432};
+
+  std::vector<u16> packed(values.size());
+  std::vector<float> unpacked(values.size());
+  PackHalf(values, packed);
+  UnpackHalf(packed, unpacked);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    auto value = (double)values[i];
+    auto scalar = (double)HalfToFloat(FloatToHalf(values[i]));
+    auto batch = (double)unpacked[i];
+
+    if (std::abs(value) >= k_min_normal) {
+      scalar_error.Add(std::abs(scalar - value) / std::abs(value));
+      batch_error.Add(std::abs(batch - value) / std::abs(value));
+    } else {
+      scalar_subnormal_error.Add(std::abs(scalar - value));
+      batch_subnormal_error.Add(std::abs(batch - value));
+    }
+
+    Check(packed[i] == FloatToHalf(values[i]), "PackHalf differs from FloatToHalf for {}", values[i]);
+  }
+
+  scalar_error.Check();
+  scalar_subnormal_error.Check();
+  batch_error.Check();
+  batch_subnormal_error.Check();
+
+  // Every half-float apart from NaN must survive the conversion to float and back unchanged.
+  std::vector<u16> halves;
+  std::vector<float> floats;
+
+  for (u32 half = 0; half <= 0xFFFF; half++) {
+    if ((half & 0x7FFF) <= 0x7C00) {
+      halves.push_back((u16)half);
+    }
+  }
+
+  floats.resize(halves.size());
+  UnpackHalf(halves, floats);
+  PackHalf(floats, packed);
+
+  for (size_t i = 0; i < halves.size(); i++) {
+    Check(FloatToHalf(HalfToFloat(halves[i])) == halves[i], "half 0x{:04X} does not survive a round trip (scalar)", halves[i]);
+    Check(packed[i] == halves[i], "half 0x{:04X} does not survive a round trip (batch)", halves[i]);
+  }
+}
+
+template<typename T>
+static void TestNormalized(
+  char const* name,
+  double max_integer,
+  double min,
+  double bound,
+  T (*pack)(float),
+  float (*unpack)(T),
+  void (*pack_batch)(ArrayView<float const>, ArrayView<T>),
+  void (*unpack_batch)(ArrayView<T const>, ArrayView<float>)
+) {
+  std::vector<float> values;
+
+  for (double i = min * max_integer; i < max_integer; i++) {
+    values.push_back((float)((i + 0.5) / max_integer));
+  }
+
+  for (int i = 0; i < 100000; i++) {
+    values.push_back(RandomFloat((float)min, 1));
+  }
+
+  values.push_back((float)min);
+  values.push_back(1);
+
+  auto scalar_error = MaxError{name, bound + k_float_rounding};
+  auto batch_error = MaxError{name, bound + k_float_rounding};
+
+  std::vector<T> packed(values.size());
+  std::vector<float> unpacked(values.size());
+  pack_batch(values, packed);
+  unpack_batch(packed, unpacked);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    scalar_error.Add(std::abs((double)unpack(pack(values[i])) - values[i]));
+    batch_error.Add(std::abs((double)unpacked[i] - values[i]));
+
+    Check(packed[i] == pack(values[i]), "{}: the batch kernel differs from the scalar conversion for {}", name, values[i]);
+  }
+
+  scalar_error.Check();
+  batch_error.Check();
+}
+
+static auto AngleBetween(Vector3 const& a, Vector3 const& b) -> double {
+  double cross_x = (double)a.Y() * b.Z() - (double)a.Z() * b.Y();
+  double cross_y = (double)a.Z() * b.X() - (double)a.X() * b.Z();
+  double cross_z = (double)a.X() * b.Y() - (double)a.Y() * b.X();
+  double dot = (double)a.X() * b.X() + (double)a.Y() * b.Y() + (double)a.Z() * b.Z();
+
+  return std::atan2(std::sqrt(cross_x * cross_x + cross_y * cross_y + cross_z * cross_z), dot);
+}
+
+static void TestOctahedral() {
+  std::vector<Vector3> normals;
+
+  for (int x = -1; x <= 1; x++) {
+    for (int y = -1; y <= 1; y++) {
+      for (int z = -1; z <= 1; z++) {
+        if (x != 0 || y != 0 || z != 0) {
+          normals.push_back(Vector3{(float)x, (float)y, (float)z}.Normalize());
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < 200000; i++) {
+    auto normal = Vector3{RandomFloat(), RandomFloat(), RandomFloat()};
+
+    if (normal.Length() > 0.01f) {
+      normals.push_back(normal.Normalize());
+    }
+  }
+
+  auto scalar_error = MaxError{"octahedral (scalar)", 6.5e-5};
+  auto batch_error = MaxError{"octahedral (batch)", 6.5e-5};
+
+  std::vector<OctahedralNormal> encoded(normals.size());
+  std::vector<Vector3> decoded(normals.size());
+  PackOctahedral(StridedArrayView<Vector3 const>{normals.data(), normals.size()}, encoded);
+  UnpackOctahedral(encoded, StridedArrayView<Vector3>{decoded.data(), decoded.size()});
+
+  for (size_t i = 0; i < normals.size(); i++) {
+    auto scalar = OctahedralNormal{normals[i]};
+
+    scalar_error.Add(AngleBetween(scalar.ToFloat(), normals[i]));
+    batch_error.Add(AngleBetween(decoded[i], normals[i]));
+
+    Check(BitEqual(encoded[i], scalar), "PackOctahedral differs from the scalar encoding for normal #{}", i);
+  }
+
+  scalar_error.Check();
+  batch_error.Check();
+}
+
+template<typename Packed>
+static void TestPacked1010102(char const* name, float min, double bound_xyz, double bound_w, std::vector<float> const& w_values) {
+  std::vector<Vector4> values;
+
+  for (int i = 0; i < 100000; i++) {
+    auto w = w_values.empty() ? RandomFloat(min, 1) : w_values[i % w_values.size()];
+
+    values.push_back(Vector4{RandomFloat(min, 1), RandomFloat(min, 1), RandomFloat(min, 1), w});
+  }
+
+  auto scalar_error_xyz = MaxError{name, bound_xyz + k_float_rounding};
+  auto scalar_error_w = MaxError{name, bound_w + k_float_rounding};
+  auto batch_error_xyz = MaxError{name, bound_xyz + k_float_rounding};
+  auto batch_error_w = MaxError{name, bound_w + k_float_rounding};
+
+  std::vector<Packed> packed(values.size());
+  std::vector<Vector4> unpacked(values.size());
+
+  if constexpr (std::is_same_v<Packed, UNorm1010102>) {
+    PackUNorm1010102(values, packed);
+    UnpackUNorm1010102(packed, unpacked);
+  } else {
+    PackSNorm1010102(values, packed);
+    UnpackSNorm1010102(packed, unpacked);
+  }
+
+  for (size_t i = 0; i < values.size(); i++) {
+    auto scalar = Packed{values[i]};
+    auto scalar_unpacked = scalar.ToFloat();
+
+    for (int j = 0; j < 3; j++) {
+      scalar_error_xyz.Add(std::abs((double)scalar_unpacked[j] - values[i][j]));
+      batch_error_xyz.Add(std::abs((double)unpacked[i][j] - values[i][j]));
+    }
+
+    scalar_error_w.Add(std::abs((double)scalar_unpacked.W() - values[i].W()));
+    batch_error_w.Add(std::abs((double)unpacked[i].W() - values[i].W()));
+
+    Check(packed[i].Bits() == scalar.Bits(), "{}: the batch kernel differs from the scalar conversion for vector #{}", name, i);
+  }
+
+  scalar_error_xyz.Check();
+  scalar_error_w.Check();
+  batch_error_xyz.Check();
+  batch_error_w.Check();
+}
+
+void TestQuantized() {
+  TestHalf();
+
+  TestNormalized<s16>("snorm16", 32767, -1, 1.0 / 65534,
+    FloatToSNorm16, SNorm16ToFloat, PackSNorm16, UnpackSNorm16);
+
+  TestNormalized<u16>("unorm16", 65535, 0, 1.0 / 131070,
+    FloatToUNorm16, UNorm16ToFloat, PackUNorm16, UnpackUNorm16);
+
+  TestOctahedral();
+
+  TestPacked1010102<UNorm1010102>("unorm 10:10:10:2", 0, 1.0 / 2046, 1.0 / 6, {});
+
+  // The handedness of a tangent must be exact.
+  TestPacked1010102<SNorm1010102>("snorm 10:10:10:2", -1, 1.0 / 1022, 0, {-1, 1});
+}
+
+} // namespace Aura
@@ -0,0 +1,74 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+// Compile the scalar fallback under a different namespace, so that it can be linked
+// into the same executable as the SIMD build without violating the one definition rule.
+#if !defined(AURA_MATH_NO_SIMD)
+  #define AURA_MATH_NO_SIMD
+#endif
+#define Aura AuraScalar
+#include <aurora/math/matrix4.hpp>
+#undef Aura
+
+#include "scalar_reference.hpp"
+
+namespace ScalarReference {
+
+using AuraScalar::Matrix4;
+using AuraScalar::Vector4;
+
+static auto Load(Matrix const& matrix) -> Matrix4 {
+  Matrix4 result;
+  for (int i = 0; i < 16; i++) result[i >> 2][i & 3] = matrix[i];
+  return result;
+}
+
+static auto Load(Vector const& vector) -> Vector4 {
+  return Vector4{vector[0], vector[1], vector[2], vector[3]};
+}
+
+static auto Store(Matrix4 const& matrix) -> Matrix {
+  Matrix result;
+  for (int i = 0; i < 16; i++) result[i] = matrix[i >> 2][i & 3];
+  return result;
+}
+
+static auto Store(Vector4 const& vector) -> Vector {
+  return {vector[0], vector[1], vector[2], vector[3]};
+}
+
+auto Multiply(Matrix const& lhs, Matrix const& rhs) -> Matrix {
+  return Store(Load(lhs) * Load(rhs));
+}
+
+auto Multiply(Matrix const& lhs, Vector const& rhs) -> Vector {
+  return Store(Load(lhs) * Load(rhs));
+}
+
+auto Inverse(Matrix const& matrix) -> Matrix {
+  return Store(Load(matrix).Inverse());
+}
+
+auto InverseAffine(Matrix const& matrix) -> Matrix {
+  return Store(Load(matrix).InverseAffine());
+}
+
+auto InverseRigid(Matrix const& matrix) -> Matrix {
+  return Store(Load(matrix).InverseRigid());
+}
+
+auto VectorOperators(Vector const& a, Vector const& b, float s) -> std::array<Vector, 9> {
+  auto u = Load(a);
+  auto v = Load(b);
+
+  auto add = u; add += v;
+  auto sub = u; sub -= v;
+  auto mul = u; mul *= s;
+  auto div = u; div /= s;
+
+  return {
+    Store(u + v), Store(u - v), Store(u * s), Store(u / s), Store(-u),
+    Store(add), Store(sub), Store(mul), Store(div)
+  };
+}
+
+} // namespace ScalarReference
@@ -0,0 +1,31 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <array>
+
+/**
+ * The scalar fallback of Aurora-Math (AURA_MATH_NO_SIMD), which the SIMD code paths must match bit for bit.
+ *
+ * Matrices are passed as their sixteen floats in memory order (column-major),
+ * so that this interface does not depend on either build of the math types.
+ */
+namespace ScalarReference {
+
+using Matrix = std::array<float, 16>;
+using Vector = std::array<float, 4>;
+
+auto Multiply(Matrix const& lhs, Matrix const& rhs) -> Matrix;
+auto Multiply(Matrix const& lhs, Vector const& rhs) -> Vector;
+auto Inverse(Matrix const& matrix) -> Matrix;
+auto InverseAffine(Matrix const& matrix) -> Matrix;
+auto InverseRigid(Matrix const& matrix) -> Matrix;
+
+/**
+ * Evaluate every Vector4 operator that has a SIMD implementation.
+ *
+ * @return a + b, a - b, a * s, a / s, -a and the compound assignment variants, in this order
+ */
+auto VectorOperators(Vector const& a, Vector const& b, float s) -> std::array<Vector, 9>;
+
+} // namespace ScalarReference
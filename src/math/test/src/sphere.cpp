@@ -0,0 +1,111 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/math/quaternion.hpp>
+#include <aurora/math/sphere.hpp>
+#include <cmath>
+
+#include "test.hpp"
+
+namespace Aura {
+
+static auto RandomDirection() -> Vector3 {
+  while (true) {
+    auto direction = Vector3{RandomFloat(), RandomFloat(), RandomFloat()};
+    auto length = direction.Length();
+
+    if (length > 0.01f && length <= 1) return direction * (1 / length);
+  }
+}
+
+static auto RandomRotation() -> Matrix4 {
+  auto quat = Quaternion{RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat()};
+  quat.Normalize();
+  return quat.ToRotationMatrix();
+}
+
+/**
+ * Check that every point on the surface of the sphere ends up inside of the transformed sphere.
+ *
+ * @param sphere  the untransformed sphere
+ * @param matrix  the transform
+ * @param name    describes the transform in failure messages
+ * @param samples the number of random points on the surface to test, in addition to the points along the axes
+ */
+static void CheckContainsTransformedSphere(Sphere const& sphere, Matrix4 const& matrix, char const* name, int samples) {
+  auto transformed = sphere.ApplyMatrix(matrix);
+  auto max_distance = 0.0f;
+
+  const auto test_direction = [&](Vector3 const& direction) {
+    auto point = matrix * Vector4{sphere.Center() + direction * sphere.Radius(), 1};
+    auto distance = (point.XYZ() - transformed.Center()).Length();
+
+    max_distance = std::max(max_distance, distance);
+  };
+
+  for (int axis = 0; axis < 3; axis++) {
+    auto direction = Vector3{};
+
+    direction[axis] = 1;
+    test_direction(direction);
+    direction[axis] = -1;
+    test_direction(direction);
+  }
+
+  for (int i = 0; i < samples; i++) test_direction(RandomDirection());
+
+  Check(max_distance <= transformed.Radius() * 1.0001f, "Sphere::ApplyMatrix ({}): a point at distance {} lies outside of radius {}",
+    name, max_distance, transformed.Radius());
+}
+
+static void TestApplyMatrix() {
+  const auto sphere = Sphere{Vector3{0.5f, -1, 2}, 1.5f};
+
+  // A non-uniformly scaled parent with a child rotated by 45 degrees. The longest column of the world matrix is
+  // about 1.58 long, but the matrix stretches the direction that the rotation maps onto the X axis by a factor of 2.
+  {
+    auto parent = Matrix4::Translation(3, 0, -1) * Matrix4::Scale(2, 1, 1);
+    auto child = Matrix4::RotationZ(0.78539816f);
+    auto world = parent * child;
+
+    CheckContainsTransformedSphere(sphere, world, "scaled parent, rotated child", 10000);
+
+    // The direction that is stretched the most is (1, -1, 0) / sqrt(2).
+    auto direction = Vector3{0.70710678f, -0.70710678f, 0};
+    auto point = world * Vector4{sphere.Center() + direction * sphere.Radius(), 1};
+    auto transformed = sphere.ApplyMatrix(world);
+
+    Check((point.XYZ() - transformed.Center()).Length() <= transformed.Radius() * 1.0001f,
+      "Sphere::ApplyMatrix (scaled parent, rotated child): the most stretched direction lies outside of the sphere");
+  }
+
+  // Random chains of a non-uniform scale and a rotation in either order.
+  for (int i = 0; i < 1000; i++) {
+    auto scale = Matrix4::Scale(RandomFloat(0.1f, 4), RandomFloat(0.1f, 4), RandomFloat(0.1f, 4));
+    auto rotation = RandomRotation();
+
+    CheckContainsTransformedSphere(sphere, rotation * scale, "rotation * scale", 100);
+    CheckContainsTransformedSphere(sphere, scale * rotation, "scale * rotation", 100);
+    CheckContainsTransformedSphere(sphere, rotation * scale * RandomRotation(), "rotation * scale * rotation", 100);
+  }
+
+  // Orthogonal basis vectors give the exact stretch: a rigid transform keeps the radius,
+  // a rotation applied after a non-uniform scale multiplies it by the largest scale.
+  for (int i = 0; i < 100; i++) {
+    auto rigid = Matrix4::Translation(RandomFloat(), RandomFloat(), RandomFloat()) * RandomRotation();
+    auto rigid_radius = sphere.ApplyMatrix(rigid).Radius();
+
+    auto scaled = RandomRotation() * Matrix4::Scale(0.5f, 3, 1);
+    auto scaled_radius = sphere.ApplyMatrix(scaled).Radius();
+
+    Check(std::abs(rigid_radius - sphere.Radius()) <= 1e-4f,
+      "Sphere::ApplyMatrix (rigid): radius is {} instead of {}", rigid_radius, sphere.Radius());
+    Check(std::abs(scaled_radius - sphere.Radius() * 3) <= 1e-3f,
+      "Sphere::ApplyMatrix (rotation * scale): radius is {} instead of {}", scaled_radius, sphere.Radius() * 3);
+  }
+}
+
+void TestSphere() {
+  TestApplyMatrix();
+}
+
+} // namespace Aura
@@ -0,0 +1,36 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <fmt/format.h>
+#include <random>
+
+namespace Aura {
+
+/**
+ * Minimal test harness: a failed check is reported and counted but does not stop the test,
+ * so that a single run reports every mismatch.
+ */
+inline int g_failure_count = 0;
+inline auto g_rng = std::mt19937{};
+
+template<typename... Args>
+auto Check(bool condition, char const* format, Args&&... args) -> bool {
+  if (!condition) {
+    fmt::print(stderr, "FAIL: ");
+    fmt::print(stderr, format, std::forward<Args>(args)...);
+    fmt::print(stderr, "\n");
+    g_failure_count++;
+  }
+  return condition;
+}
+
+inline auto RandomFloat(float min = -1, float max = 1) -> float {
+  return std::uniform_real_distribution<float>{min, max}(g_rng);
+}
+
+void TestMatrix4();
+void TestQuantized();
+void TestSphere();
+
+} // namespace Aura
@@ -16,6 +16,7 @@ struct Camera : Component {
 
   virtual auto get_frustum() const -> Frustum const& = 0;
   virtual auto get_projection() const -> Matrix4 const& = 0;
+  virtual auto get_projection_inverse() const -> Matrix4 const& = 0;
 };
 
 struct PerspectiveCamera final : Camera {
@@ -89,9 +90,14 @@ struct PerspectiveCamera final : Camera {
     return projection;
   }
 
+  auto get_projection_inverse() const -> Matrix4 const& override {
+    return projection_inverse;
+  }
+
 private:
   void update() {
     projection = Matrix4::PerspectiveVK(field_of_view, aspect_ratio, near, far);
+    projection_inverse = projection.Inverse();
 
     float x = 1 / projection.X().X();
     float y = 1 / projection.Y().Y();
@@ -110,6 +116,7 @@ private:
   float far = 500.0;
   Frustum frustum;
   Matrix4 projection;
+  Matrix4 projection_inverse;
 };
 
 struct OrthographicCamera final : Camera {
@@ -207,6 +214,10 @@ struct OrthographicCamera final : Camera {
     return projection;
   }
 
+  auto get_projection_inverse() const -> Matrix4 const& override {
+    return projection_inverse;
+  }
+
 private:
   void update() {
     frustum.SetPlane(Frustum::Side::NZ, Plane{Vector3{ 0,  0, -1}, -near});
@@ -218,6 +229,7 @@ private:
 
     // TODO: fix the depth range
     projection = Matrix4::OrthographicGL(left, right, bottom, top, near, far);
+    projection_inverse = projection.Inverse(MatrixClass::Affine);
   }
 
   float left = -1.0;
@@ -228,6 +240,7 @@ private:
   float far = 500.0;
   Frustum frustum;
   Matrix4 projection;
+  Matrix4 projection_inverse;
 };
 
 } // namespace Aura
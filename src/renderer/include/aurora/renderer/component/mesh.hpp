@@ -4,13 +4,23 @@
 #pragma once
 
 #include <aurora/renderer/geometry/geometry.hpp>
+#include <aurora/renderer/gpu_resource.hpp>
 #include <aurora/renderer/material.hpp>
 #include <aurora/scene/component.hpp>
+#include <aurora/scene/game_object.hpp>
+#include <aurora/integer.hpp>
 #include <memory>
 
 namespace Aura {
 
-struct Mesh final : Component {
+/**
+ * Renders a geometry with a material at the world transform of the owning GameObject.
+ *
+ * Changing the geometry, the material or the visibility notifies the {@link #SceneListener}s.
+ * Renderers cache per-mesh GPU state, which is recreated when needs_update() is set and released
+ * when the mesh is destroyed (see {@link #GPUResource}).
+ */
+struct Mesh final : Component, GPUResource {
   Mesh(
     GameObject* owner,
     std::shared_ptr<Geometry> geometry,
@@ -20,10 +30,92 @@ struct Mesh final : Component {
       , material(material) {
   }
 
+  auto get_geometry() const -> std::shared_ptr<Geometry> const& {
+    return geometry;
+  }
+
+  void set_geometry(std::shared_ptr<Geometry> geometry) {
+    this->geometry = geometry;
+    needs_update() = true;
+    owner()->notify_component_changed(this);
+  }
+
+  auto get_material() const -> std::shared_ptr<Material> const& {
+    return material;
+  }
+
+  void set_material(std::shared_ptr<Material> material) {
+    this->material = material;
+    needs_update() = true;
+    owner()->notify_component_changed(this);
+  }
+
+  bool visible() const {
+    return visible_;
+  }
+
+  void set_visible(bool visible) {
+    if (visible_ != visible) {
+      visible_ = visible;
+      owner()->notify_component_changed(this);
+    }
+  }
+
+  /**
+   * Get the bounding box of the geometry in world space.
+   * The box is cached and only recomputed when the world matrix of the owner changed or the geometry was replaced or edited.
+   *
+   * @return the world-space bounding box
+   */
+  auto get_world_bounding_box() -> Box3 const& {
+    auto& transform = owner()->transform();
+
+    if (transform.world_version() != world_bounding_box_version ||
+        geometry.get() != world_bounding_box_geometry ||
+        geometry->get_version() != world_bounding_box_geometry_version) {
+      world_bounding_box = geometry->get_bounding_box().ApplyMatrix(transform.world());
+      world_bounding_box_version = transform.world_version();
+      world_bounding_box_geometry = geometry.get();
+      world_bounding_box_geometry_version = geometry->get_version();
+    }
+
+    return world_bounding_box;
+  }
+
+  /**
+   * Get the bounding sphere of the geometry in world space.
+   * The sphere is cached and only recomputed when the world matrix of the owner changed or the geometry was replaced or edited.
+   *
+   * @return the world-space bounding sphere
+   */
+  auto get_world_bounding_sphere() -> Sphere const& {
+    auto& transform = owner()->transform();
+
+    if (transform.world_version() != world_bounding_sphere_version ||
+        geometry.get() != world_bounding_sphere_geometry ||
+        geometry->get_version() != world_bounding_sphere_geometry_version) {
+      world_bounding_sphere = geometry->get_bounding_sphere().ApplyMatrix(transform.world());
+      world_bounding_sphere_version = transform.world_version();
+      world_bounding_sphere_geometry = geometry.get();
+      world_bounding_sphere_geometry_version = geometry->get_version();
+    }
+
+    return world_bounding_sphere;
+  }
+
+private:
   std::shared_ptr<Geometry> geometry;
   std::shared_ptr<Material> material;
+  bool visible_ = true;
 
-  bool visible = true;
+  Box3 world_bounding_box;
+  u32 world_bounding_box_version = 0;
+  Geometry* world_bounding_box_geometry = nullptr;
+  u32 world_bounding_box_geometry_version = 0;
+  Sphere world_bounding_sphere;
+  u32 world_bounding_sphere_version = 0;
+  Geometry* world_bounding_sphere_geometry = nullptr;
+  u32 world_bounding_sphere_geometry_version = 0;
 };
 
 } // namespace Aura
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <aurora/math/batch.hpp>
 #include <aurora/math/box3.hpp>
+#include <aurora/math/bvh.hpp>
+#include <aurora/math/sphere.hpp>
+#include <aurora/math/triangle.hpp>
 #include <aurora/renderer/geometry/index_buffer.hpp>
 #include <aurora/renderer/geometry/vertex_buffer.hpp>
 #include <aurora/any_ptr.hpp>
@@ -28,13 +32,58 @@ struct Geometry final : GPUResource {
     Triangles
   };
 
+  /**
+   * Gives access to the object-space triangles of a geometry.
+   * The position attribute and the index buffer are looked up once when the view is created (see {@link #get_triangles}),
+   * so that accessing many triangles does not repeat the lookup. The view is invalidated when the geometry changes.
+   */
+  struct TriangleView {
+    TriangleView(StridedArrayView<Vector3 const> positions, IndexBuffer const* index_buffer) : positions(positions) {
+      if (index_buffer) {
+        if (index_buffer->data_type() == IndexDataType::UInt16) {
+          indices_u16 = index_buffer->view<u16>();
+          count = indices_u16.size() / 3;
+        } else {
+          indices_u32 = index_buffer->view<u32>();
+          count = indices_u32.size() / 3;
+        }
+      } else {
+        count = positions.size() / 3;
+      }
+    }
+
+    auto size() const -> size_t {
+      return count;
+    }
+
+    auto operator[](size_t index) const -> Triangle {
+      auto first = index * 3;
+
+      if (!indices_u16.empty()) {
+        return Triangle{positions[indices_u16[first]], positions[indices_u16[first + 1]], positions[indices_u16[first + 2]]};
+      }
+
+      if (!indices_u32.empty()) {
+        return Triangle{positions[indices_u32[first]], positions[indices_u32[first + 1]], positions[indices_u32[first + 2]]};
+      }
+
+      return Triangle{positions[first], positions[first + 1], positions[first + 2]};
+    }
+
+  private:
+    StridedArrayView<Vector3 const> positions;
+    ArrayView<u16 const> indices_u16;
+    ArrayView<u32 const> indices_u32;
+    size_t count;
+  };
+
   auto get_index_buffer() const -> std::shared_ptr<IndexBuffer> const& {
     return index_buffer;
   }
 
   void set_index_buffer(std::shared_ptr<IndexBuffer> index_buffer) {
     this->index_buffer = index_buffer;
-    needs_update() = true;
+    invalidate();
   }
 
   auto get_vertex_buffers() const -> ArrayView<const std::shared_ptr<VertexBuffer>> {
@@ -44,7 +93,7 @@ struct Geometry final : GPUResource {
 
   void add_vertex_buffer(std::shared_ptr<VertexBuffer> vertex_buffer) {
     vertex_buffers.push_back(vertex_buffer);
-    needs_update() = true;
+    invalidate();
   }
 
   auto get_attributes() const -> ArrayView<const Attribute> {
@@ -53,7 +102,7 @@ struct Geometry final : GPUResource {
 
   void add_attribute(Attribute attribute) {
     attributes.push_back(attribute);
-    needs_update() = true;
+    invalidate();
   }
 
   auto get_topology() const -> Topology {
@@ -64,6 +113,26 @@ struct Geometry final : GPUResource {
     this->topology = topology;
   }
 
+  /**
+   * Get the version of the geometry, which is incremented whenever the buffers or attributes are replaced.
+   * Caches of data that is derived from the geometry (for example world-space bounds) compare it to detect that they are stale.
+   *
+   * @return the version
+   */
+  auto get_version() const -> u32 {
+    return version;
+  }
+
+  /**
+   * Get a counter that is incremented whenever the version of any geometry is incremented,
+   * so that caches over many geometries only have to compare their versions after a geometry changed.
+   *
+   * @return the global version
+   */
+  static auto get_global_version() -> u64 {
+    return global_version;
+  }
+
   auto get_bounding_box() -> Box3 const& {
     if (!have_bounding_box) {
       compute_bounding_box();
@@ -72,59 +141,148 @@ struct Geometry final : GPUResource {
     return bounding_box;
   }
 
-  void compute_bounding_box() {
-    auto position_attribute = std::find_if(
-      attributes.begin(), attributes.end(), [](Attribute const& attribute) {
-        return attribute.location == 0;});
-
-    if (position_attribute == attributes.end()) {
-      return;
+  auto get_bounding_sphere() -> Sphere const& {
+    if (!have_bounding_box) {
+      compute_bounding_box();
     }
 
-    if (position_attribute->buffer >= vertex_buffers.size()) {
-      return;
+    return bounding_sphere;
+  }
+
+  /**
+   * Get the number of triangles, which are either defined by the index buffer or by consecutive vertices.
+   * @return the number of triangles
+   */
+  auto get_triangle_count() const -> size_t {
+    if (index_buffer) {
+      auto index_size = index_buffer->data_type() == IndexDataType::UInt16 ? sizeof(u16) : sizeof(u32);
+
+      return index_buffer->size() / index_size / 3;
     }
 
-    if (position_attribute->data_type != VertexDataType::Float32 &&
-        position_attribute->components != 3) {
-      Log<Warn>("Geometry: cannot calculate bounding box: position attribute is not in F32x3 format");
-      return;
+    if (auto positions = get_positions()) {
+      return positions->size() / 3;
     }
+    return 0;
+  }
 
-    bounding_box.Min().X() = +std::numeric_limits<float>::infinity();
-    bounding_box.Min().Y() = +std::numeric_limits<float>::infinity();
-    bounding_box.Min().Z() = +std::numeric_limits<float>::infinity();
+  /**
+   * Get a view of the triangles in object space. The position attribute must be in F32x3 format.
+   *
+   * @return the triangles or std::nullopt if the geometry has no usable position attribute
+   */
+  auto get_triangles() const -> std::optional<TriangleView> {
+    if (auto positions = get_positions()) {
+      return TriangleView{*positions, index_buffer.get()};
+    }
+    return std::nullopt;
+  }
 
-    bounding_box.Max().X() = -std::numeric_limits<float>::infinity();
-    bounding_box.Max().Y() = -std::numeric_limits<float>::infinity();
-    bounding_box.Max().Z() = -std::numeric_limits<float>::infinity();
+  /**
+   * Get a triangle in object space. The position attribute must be in F32x3 format.
+   * Use {@link #get_triangles} to access many triangles.
+   *
+   * @param index the index of the triangle
+   * @return the triangle
+   */
+  auto get_triangle(size_t index) const -> Triangle {
+    return get_triangles().value()[index];
+  }
 
-    auto& buffer = vertex_buffers[position_attribute->buffer];
-    auto  length = buffer->size() / buffer->stride();
-    auto  offset = position_attribute->offset;
+  /**
+   * Get a {@link #BVH} over the object-space bounding boxes of the triangles, for spatial queries.
+   * The item of each leaf is the index of its triangle.
+   * The BVH is built on first use and rebuilt once the buffers or attributes have been replaced.
+   *
+   * @return the triangle BVH
+   */
+  auto get_triangle_bvh() -> BVH const& {
+    if (!have_triangle_bvh) {
+      compute_triangle_bvh();
+    }
 
-    for (size_t i = 0; i < length; i++) {
-      auto position = buffer->read<Vector3>(i, offset, 0);
+    return triangle_bvh;
+  }
 
-      bounding_box.Min().X() = std::min(bounding_box.Min().X(), position.X());
-      bounding_box.Min().Y() = std::min(bounding_box.Min().Y(), position.Y());
-      bounding_box.Min().Z() = std::min(bounding_box.Min().Z(), position.Z());
+  /**
+   * Compute the bounding box and the bounding sphere from the position attribute.
+   * The sphere is centered on the box and encloses all vertices.
+   */
+  void compute_bounding_box() {
+    auto positions = get_positions();
 
-      bounding_box.Max().X() = std::max(bounding_box.Max().X(), position.X());
-      bounding_box.Max().Y() = std::max(bounding_box.Max().Y(), position.Y());
-      bounding_box.Max().Z() = std::max(bounding_box.Max().Z(), position.Z());
+    if (!positions) {
+      return;
     }
 
+    bounding_box = ComputeBoundingBox(*positions);
+    bounding_sphere = ComputeBoundingSphere(*positions, bounding_box.Center());
+
     have_bounding_box = true;
   }
 
+  /**
+   * Compute the triangle BVH from the position attribute and the index buffer.
+   */
+  void compute_triangle_bvh() {
+    std::vector<Box3> boxes;
+
+    if (auto triangles = get_triangles()) {
+      boxes.reserve(triangles->size());
+
+      for (size_t i = 0; i < triangles->size(); i++) {
+        boxes.push_back((*triangles)[i].GetBoundingBox());
+      }
+    }
+
+    triangle_bvh.Build(boxes);
+    have_triangle_bvh = true;
+  }
+
 private:
   std::shared_ptr<IndexBuffer> index_buffer;
   std::vector<std::shared_ptr<VertexBuffer>> vertex_buffers;
   std::vector<Attribute> attributes;
   Topology topology = Topology::Triangles;
   Box3 bounding_box;
+  Sphere bounding_sphere;
   bool have_bounding_box = false;
+  BVH triangle_bvh;
+  bool have_triangle_bvh = false;
+  u32 version = 1;
+
+  static inline u64 global_version = 0;
+
+  void invalidate() {
+    needs_update() = true;
+    have_bounding_box = false;
+    have_triangle_bvh = false;
+    version++;
+    global_version++;
+  }
+
+  auto get_positions() const -> std::optional<StridedArrayView<Vector3 const>> {
+    auto position_attribute = std::find_if(
+      attributes.begin(), attributes.end(), [](Attribute const& attribute) {
+        return attribute.location == 0;});
+
+    if (position_attribute == attributes.end()) {
+      return std::nullopt;
+    }
+
+    if (position_attribute->buffer >= vertex_buffers.size()) {
+      return std::nullopt;
+    }
+
+    if (position_attribute->data_type != VertexDataType::Float32 ||
+        position_attribute->components != 3) {
+      Log<Warn>("Geometry: position attribute is not in F32x3 format");
+      return std::nullopt;
+    }
+
+    return StridedArrayView<Vector3 const>{
+      vertex_buffers[position_attribute->buffer]->strided_view<Vector3>(position_attribute->offset)};
+  }
 };
 
 } // namespace Aura
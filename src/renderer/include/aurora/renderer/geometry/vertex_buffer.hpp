@@ -7,6 +7,7 @@
 #include <aurora/renderer/gpu_resource.hpp>
 #include <aurora/array_view.hpp>
 #include <aurora/integer.hpp>
+#include <aurora/strided_array_view.hpp>
 #include <vector>
 
 namespace Aura {
@@ -50,6 +51,23 @@ struct VertexBuffer final : GPUResource {
     return ArrayView<T>{(T*)data(), size() / sizeof(T)};
   }
 
+  /**
+   * Get a view of one attribute of each vertex in this buffer.
+   *
+   * @tparam T     the attribute type
+   * @param offset the byte offset of the attribute within a vertex
+   * @return the strided view
+   */
+  template<typename T>
+  auto strided_view(size_t offset = 0) const -> StridedArrayView<T const> {
+    return StridedArrayView<T const>{(T const*)(data() + offset), size() / stride(), stride()};
+  }
+
+  template<typename T>
+  auto strided_view(size_t offset = 0) -> StridedArrayView<T> {
+    return StridedArrayView<T>{(T*)(data() + offset), size() / stride(), stride()};
+  }
+
   template<typename T>
   auto read(size_t id, size_t offset = 0, size_t component = 0) -> T& {
     return ((T*)(data() + id * stride() + offset))[component];
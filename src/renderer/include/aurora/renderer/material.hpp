@@ -4,11 +4,13 @@
 #pragma once
 
 #include <aurora/gal/render_device.hpp>
+#include <aurora/renderer/gpu_resource.hpp>
 #include <aurora/renderer/texture.hpp>
 #include <aurora/renderer/uniform_block.hpp>
 #include <aurora/array_view.hpp>
 #include <aurora/integer.hpp>
 #include <aurora/log.hpp>
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -17,13 +19,31 @@
 
 namespace Aura {
 
-struct Material {
+/**
+ * Renderers cache per-material GPU state, such as the bind group of the uniforms and textures,
+ * which is released when the material is destroyed (see {@link #GPUResource}).
+ */
+struct Material : GPUResource {
   enum class Side {
     Front,
     Back,
     Both
   };
 
+  /**
+   * Per-draw values that the renderer passes to the shaders as push constants.
+   * The requested values are packed in the order of their declaration here, so for example
+   * a material that only requests the model matrix declares it as follows:
+   *
+   *   layout (push_constant) uniform Draw {
+   *     mat4 u_model;
+   *   };
+   */
+  enum class DrawData : u32 {
+    None = 0,
+    ModelMatrix = 1
+  };
+
   struct BlendState {
     bool enable = false;
     BlendFactor src_color_factor = BlendFactor::SrcAlpha;
@@ -33,6 +53,17 @@ struct Material {
     BlendOp color_op = BlendOp::Add;
     BlendOp alpha_op = BlendOp::Add;
     float constants[4]{ 0, 0, 0, 0 };
+
+    bool operator==(BlendState const& other) const {
+      return enable == other.enable &&
+             src_color_factor == other.src_color_factor &&
+             dst_color_factor == other.dst_color_factor &&
+             src_alpha_factor == other.src_alpha_factor &&
+             dst_alpha_factor == other.dst_alpha_factor &&
+             color_op == other.color_op &&
+             alpha_op == other.alpha_op &&
+             std::equal(constants, constants + 4, other.constants);
+    }
   } blend_state;
 
   Material(std::vector<std::string> const& compile_options = {})
@@ -60,6 +91,14 @@ struct Material {
     return side_;
   }
 
+  auto draw_data() const -> DrawData {
+    return draw_data_;
+  }
+
+  auto draw_data() -> DrawData& {
+    return draw_data_;
+  }
+
   auto get_compile_options() const -> u32 {
     return compile_options_;
   }
@@ -85,11 +124,20 @@ protected:
 
 private:
   Side side_ = Side::Front;
+  DrawData draw_data_ = DrawData::None;
   u32 compile_options_ = 0;
   std::unordered_map<std::string, size_t> compile_options_map_;
   std::vector<std::string> compile_option_names_;
 };
 
+constexpr auto operator|(Material::DrawData lhs, Material::DrawData rhs) -> Material::DrawData {
+  return (Material::DrawData)((u32)lhs | (u32)rhs);
+}
+
+constexpr auto operator&(Material::DrawData lhs, Material::DrawData rhs) -> Material::DrawData {
+  return (Material::DrawData)((u32)lhs & (u32)rhs);
+}
+
 struct PbrMaterial final : Material {
   PbrMaterial() : Material({
     "ENABLE_ALBEDO_MAP",
@@ -98,10 +146,11 @@ struct PbrMaterial final : Material {
     "ENABLE_NORMAL_MAP"
   }) {
     auto layout = UniformBlockLayout{};
-    layout.add<Matrix4>("model");
     layout.add<float>("metalness");
     layout.add<float>("roughness");
     uniforms_ = UniformBlock{layout};
+
+    draw_data() = DrawData::ModelMatrix;
   }
 
   auto metalness() -> float& {
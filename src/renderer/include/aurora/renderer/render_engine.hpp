@@ -4,6 +4,8 @@
 #pragma once
 
 #include <aurora/gal/render_device.hpp>
+#include <aurora/renderer/render_statistics.hpp>
+#include <aurora/renderer/scene_bvh.hpp>
 #include <aurora/scene/game_object.hpp>
 #include <memory>
 
@@ -22,6 +24,12 @@ struct RenderEngineBase {
   ) = 0;
 
   virtual auto GetOutputTexture() -> Texture* = 0;
+  virtual auto GetStatistics() const -> RenderStatistics const& = 0;
+
+  /**
+   * Get the BVH of the renderable meshes that the render pipeline culls against, for example to construct a {@link #SceneQuery}.
+   */
+  virtual auto GetSceneBVH() -> SceneBVH& = 0;
 };
 
 auto CreateRenderEngine(
@@ -0,0 +1,24 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/integer.hpp>
+
+namespace Aura {
+
+/**
+ * Counters that describe the work done by the renderer for the last frame.
+ */
+struct RenderStatistics {
+  u32 transforms_updated = 0; /**< number of world matrices that were recomputed */
+  u32 draw_calls = 0; /**< number of objects that were drawn */
+  u32 pipeline_changes = 0; /**< number of times a different pipeline was bound than for the previous draw */
+  u32 material_changes = 0; /**< number of times a different material was used than for the previous draw */
+  u32 geometry_changes = 0; /**< number of times a different geometry was used than for the previous draw */
+  u32 binds = 0; /**< number of pipeline, bind group, vertex buffer and index buffer binds that were recorded */
+  u32 binds_elided = 0; /**< number of binds that were dropped because the state was already bound */
+  u32 uniform_bytes = 0; /**< number of bytes of per-frame uniform data written, including alignment padding */
+  float sort_time = 0; /**< time spent sorting the render list, in milliseconds */
+};
+
+} // namespace Aura
@@ -0,0 +1,107 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/bvh.hpp>
+#include <aurora/math/frustum.hpp>
+#include <aurora/renderer/component/mesh.hpp>
+#include <aurora/scene/game_object.hpp>
+#include <aurora/scene/scene_listener.hpp>
+#include <aurora/integer.hpp>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * A persistent registry of the renderable meshes in a scene, stored in a {@link #BVH} over their world-space bounding boxes.
+ *
+ * A mesh is renderable if it is visible, has a geometry and its object is visible in the hierarchy.
+ * The registry is maintained incrementally through {@link #SceneListener} notifications,
+ * so that the per-frame work is limited to refitting the meshes whose world matrix changed during
+ * the last TransformSystem::update() or whose geometry was edited. The hierarchy is rebuilt once its quality has degraded too much.
+ */
+struct SceneBVH final : SceneListener {
+  /**
+   * Bring the hierarchy up-to-date with a scene. Must be called after TransformSystem::update().
+   * The scene is walked once when it is first seen, afterwards changes are tracked through notifications.
+   *
+   * @param scene the root object of the scene
+   */
+  void Update(GameObject* scene);
+
+  /**
+   * Visit the meshes that may be inside a frustum. See {@link #BVH::CullFrustum}.
+   *
+   * @param frustum the frustum
+   * @param visit   a function that is called with the mesh and whether its bounding box is fully inside of the frustum
+   */
+  template<typename Visit>
+  void CullFrustum(Frustum const& frustum, Visit&& visit) const {
+    bvh.CullFrustum(frustum, [&](u32 item, bool inside) {
+      visit(GetMesh(item), inside);
+    });
+  }
+
+  auto GetBVH() const -> BVH const& {
+    return bvh;
+  }
+
+  auto GetMesh(u32 item) const -> Mesh* {
+    return entries[item].mesh;
+  }
+
+  /**
+   * Get the number of meshes that are currently registered.
+   */
+  auto GetMeshCount() const -> size_t {
+    return mesh_count;
+  }
+
+  /**
+   * Get the number of times the hierarchy was rebuilt, either because the scene changed or because its quality degraded.
+   */
+  auto GetRebuildCount() const -> u32 {
+    return rebuild_count;
+  }
+
+  void on_child_added(GameObject* parent, GameObject* child) override;
+  void on_child_removed(GameObject* parent, GameObject* child) override;
+  void on_component_added(GameObject* object, Component* component) override;
+  void on_component_removed(GameObject* object, Component* component) override;
+  void on_component_changed(GameObject* object, Component* component) override;
+  void on_visibility_changed(GameObject* object) override;
+  void on_destroyed(GameObject* object) override;
+
+private:
+  // Rebuild once the SAH cost has grown by this factor since the last rebuild.
+  static constexpr float k_rebuild_cost_factor = 1.5f;
+
+  // The item of each leaf in the BVH is the transform id of the mesh's object, which indexes the entries.
+  struct Entry {
+    Mesh* mesh = nullptr;
+    u32 proxy = BVH::k_null;
+    u32 geometry_version = 0; /**< the version of the geometry when the leaf was last updated */
+  };
+
+  bool IsInScene(GameObject* object) const;
+  bool IsRenderable(GameObject* object) const;
+  void AddSubtree(GameObject* object);
+  void RemoveSubtree(GameObject* object);
+  void AddMesh(GameObject* object);
+  void RemoveMesh(GameObject* object);
+  void UpdateMesh(Entry& entry);
+  void Build(GameObject* scene);
+  void Rebuild();
+
+  BVH bvh;
+  std::vector<Entry> entries; /**< indexed by transform id */
+  size_t mesh_count = 0;
+
+  GameObject* scene = nullptr;
+  u64 transform_update_count = 0;
+  u64 geometry_global_version = 0;
+  float rebuild_cost = 0;
+  u32 rebuild_count = 0;
+};
+
+} // namespace Aura
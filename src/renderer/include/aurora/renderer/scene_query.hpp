@@ -0,0 +1,87 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/box3.hpp>
+#include <aurora/math/ray.hpp>
+#include <aurora/math/sphere.hpp>
+#include <aurora/renderer/component/mesh.hpp>
+#include <aurora/renderer/scene_bvh.hpp>
+#include <aurora/scene/game_object.hpp>
+#include <aurora/integer.hpp>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Aura {
+
+/**
+ * Spatial queries against the triangles of the visible meshes in a scene, for example for mouse picking.
+ *
+ * Candidate meshes are found through a {@link #SceneBVH} and the triangles of each candidate through the triangle BVH
+ * of its geometry (see Geometry::get_triangle_bvh()), which is built on first use and shared by all meshes
+ * that use the geometry. The SceneBVH is not owned by the query, so that it can share the one that the render pipeline
+ * maintains anyway (see RenderEngineBase::GetSceneBVH()).
+ *
+ * Queries use the world matrices as of the last TransformSystem::update().
+ */
+struct SceneQuery {
+  struct Hit {
+    GameObject* object;
+    Mesh* mesh;
+    float distance; /**< the distance from the ray origin or from the center of the query volume */
+    u32 triangle; /**< the index of the triangle in the geometry of the mesh */
+  };
+
+  /**
+   * Construct a SceneQuery for a scene.
+   *
+   * @param scene     the root object of the scene
+   * @param scene_bvh the BVH of the scene, which is brought up-to-date before each query and must outlive the query
+   */
+  SceneQuery(GameObject* scene, SceneBVH& scene_bvh) : scene(scene), scene_bvh(scene_bvh) {}
+
+  /**
+   * Find the closest triangle that is hit by a ray.
+   *
+   * @param ray          the world-space ray, whose direction does not need to be normalized
+   * @param max_distance the distance after which hits are ignored
+   * @return the closest hit or std::nullopt if the ray does not hit any triangle
+   */
+  auto Raycast(Ray const& ray, float max_distance = std::numeric_limits<float>::infinity()) -> std::optional<Hit>;
+
+  /**
+   * Find all meshes that have at least one triangle that intersects a sphere.
+   * For each mesh, the triangle that is closest to the center of the sphere is reported.
+   *
+   * @param sphere the world-space sphere
+   * @return the hits, sorted by distance
+   */
+  auto OverlapSphere(Sphere const& sphere) -> std::vector<Hit>;
+
+  /**
+   * Find all meshes that have at least one triangle that intersects an axis-aligned box.
+   * For each mesh, the triangle that is closest to the center of the box is reported.
+   *
+   * @param box the world-space box
+   * @return the hits, sorted by distance
+   */
+  auto OverlapBox(Box3 const& box) -> std::vector<Hit>;
+
+private:
+  template<typename Test, typename Visit>
+  void QueryMeshes(Test&& test, Visit&& visit);
+
+  template<typename TestBox, typename TestTriangle>
+  auto Overlap(
+    Box3 const& bounds,
+    Vector3 const& center,
+    TestBox&& test_box,
+    TestTriangle&& test_triangle
+  ) -> std::vector<Hit>;
+
+  GameObject* scene;
+  SceneBVH& scene_bvh;
+};
+
+} // namespace Aura
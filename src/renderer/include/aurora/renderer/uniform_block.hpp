@@ -253,7 +253,7 @@ struct UniformBlock final : GPUResource {
 
 private:
   u8* data_ = nullptr;
-  size_t size_;
+  size_t size_ = 0;
   std::unordered_map<std::string, Member> members_;
 };
 
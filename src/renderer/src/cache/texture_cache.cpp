@@ -16,21 +16,31 @@ auto TextureCache::Get(AnyPtr<Texture2D> texture) -> Entry const& {
   auto& entry = cache[texture.get()];
 
   if (!entry.texture) {
-    CreateTexture(entry, texture);
+    CreateTexture(entry, texture->width(), texture->height());
     CreateSampler(entry);
-    Upload(entry, texture);
+    Upload(entry, texture->width(), texture->height(), texture->data());
   }
 
   return entry;
 }
 
+auto TextureCache::GetFallback() -> Entry const& {
+  if (!fallback.texture) {
+    const u32 white = 0xFFFFFFFF;
+
+    CreateTexture(fallback, 1, 1);
+    CreateSampler(fallback);
+    Upload(fallback, 1, 1, &white);
+  }
+
+  return fallback;
+}
+
 void TextureCache::SetCommandBuffer(CommandBuffer* command_buffer) {
   this->command_buffer = command_buffer;
 }
 
-void TextureCache::CreateTexture(Entry& entry, AnyPtr<Texture2D> texture) {
-  auto width = texture->width();
-  auto height = texture->height();
+void TextureCache::CreateTexture(Entry& entry, uint width, uint height) {
   auto usage = Texture::Usage::CopyDst | Texture::Usage::Sampled;
   auto mip_count = GetNumberOfMips(width, height);
 
@@ -60,14 +70,12 @@ void TextureCache::CreateSampler(Entry& entry) {
   });
 }
 
-void TextureCache::Upload(Entry& entry, AnyPtr<Texture2D> texture) {
-  auto width = texture->width();
-  auto height = texture->height();
+void TextureCache::Upload(Entry& entry, uint width, uint height, void const* data) {
   auto buffer_size = width * height * sizeof(u32);
 
   if (!entry.staging_buffer || entry.staging_buffer->Size() != buffer_size) {
     entry.staging_buffer = render_device->CreateBufferWithData(
-      Buffer::Usage::CopySrc, texture->data(), buffer_size);
+      Buffer::Usage::CopySrc, data, buffer_size);
   }
 
   auto barrier = MemoryBarrier{
@@ -21,12 +21,13 @@ struct TextureCache {
   TextureCache(std::shared_ptr<RenderDevice> render_device);
 
   auto Get(AnyPtr<Texture2D> texture) -> Entry const&;
+  auto GetFallback() -> Entry const&;
   void SetCommandBuffer(CommandBuffer* command_buffer);
 
 private:
-  void CreateTexture(Entry& entry, AnyPtr<Texture2D> texture);
+  void CreateTexture(Entry& entry, uint width, uint height);
   void CreateSampler(Entry& entry);
-  void Upload(Entry& entry, AnyPtr<Texture2D> texture);
+  void Upload(Entry& entry, uint width, uint height, void const* data);
   void GenerateMipMaps(AnyPtr<Texture> texture);
 
   static auto GetNumberOfMips(int width, int height, int depth = 1) -> int;
@@ -35,6 +36,7 @@ private:
   CommandBuffer* command_buffer;
 
   std::unordered_map<Texture2D*, Entry> cache;
+  Entry fallback; /**< a 1x1 white texture for texture slots that have no texture */
 };
 
 } // namespace Aura
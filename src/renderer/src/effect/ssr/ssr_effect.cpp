@@ -33,7 +33,7 @@ void SSREffect::Render(
     auto cam = camera->get_component<PerspectiveCamera>();
     auto& projection = cam->get_projection();
     uniform_block.get<Matrix4>("projection") = projection;
-    uniform_block.get<Matrix4>("projection_inverse") = projection.Inverse();
+    uniform_block.get<Matrix4>("projection_inverse") = cam->get_projection_inverse();
   } else {
     Assert(false, "SSREffect: unsupported camera type");
   }
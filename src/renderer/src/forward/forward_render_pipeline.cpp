@@ -1,11 +1,16 @@
 
 // Copyright (C) 2022 fleroviux. All rights reserved.
 
+#include <aurora/gal/state_caching_command_buffer.hpp>
+#include <aurora/radix_sort.hpp>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <shaderc/shaderc.hpp>
 #include <vector>
 
 #include "forward_render_pipeline.hpp"
+#include "sort_key.hpp"
 
 namespace Aura {
 
@@ -16,6 +21,7 @@ ForwardRenderPipeline::ForwardRenderPipeline(
 )   : render_device(render_device)
     , geometry_cache(geometry_cache)
     , texture_cache_(texture_cache) {
+  uniform_ring_buffer = std::make_unique<UniformRingBuffer>(render_device, k_uniform_ring_buffer_frame_size);
   CreateCameraUniformBlock();
   CreateRenderTarget();
   CreateBindGroupAndPipelineLayout();
@@ -26,70 +32,152 @@ void ForwardRenderPipeline::Render(
   GameObject* camera,
   std::array<std::unique_ptr<CommandBuffer>, 2>& command_buffers
 ) {
-  std::vector<Renderable> render_list_opaque;
-  std::vector<Renderable> render_list_transparent;
-
-  const std::function<void(GameObject*)> record_render_list = [&](GameObject* object) {
-    if (!object->visible()) {
-      return;
+  render_list.clear();
+  draw_keys.clear();
+  uniform_ring_buffer->NextFrame();
+  render_list_candidates.clear();
+  candidate_bounding_boxes.Clear();
+
+  statistics = {};
+
+  const auto add_renderable = [&](Renderable renderable) {
+    auto& view = *camera_data.view;
+    auto& position = renderable.object->transform().world().W();
+    auto& object_data = GetObjectData(renderable.mesh);
+    auto pipeline_id = object_data.pipeline->id;
+    auto material_id = SortKey::HashPointer(renderable.mesh->get_material().get());
+    auto geometry_id = SortKey::HashPointer(renderable.mesh->get_geometry().get());
+
+    // The camera looks along the negative z-axis in view space.
+    auto depth = -(view.X().Z() * position.X() +
+                   view.Y().Z() * position.Y() +
+                   view.Z().Z() * position.Z() +
+                   view.W().Z());
+
+    u64 key;
+
+    if (renderable.mesh->get_material()->blend_state.enable) {
+      key = SortKey::Transparent(pipeline_id, material_id, depth);
+    } else {
+      key = SortKey::Opaque(pipeline_id, material_id, geometry_id, depth);
     }
 
-    auto& transform = object->transform();
-    if (transform.auto_update()) {
-      transform.update_local();
-    }
-    transform.update_world(false);
-
-    auto mesh = object->get_component<Mesh>();
-    auto modelview = *camera_data.view * transform.world();
-
-    // TODO: calculate view * world here and use it both for sorting and for culling.
-    if (mesh && mesh->visible && IsObjectInsideCameraFrustum(modelview, mesh->geometry)) {
-      auto& position = transform.position();
-      auto  view_z = modelview.X().Z() * position.X() +
-                     modelview.Y().Z() * position.Y() +
-                     modelview.Z().Z() * position.Z() +
-                     modelview.W().Z();
-
-      if (mesh->material->blend_state.enable) {
-        render_list_transparent.push_back({object, mesh, view_z});
-      } else {
-        render_list_opaque.push_back({object, mesh, view_z});
+    renderable.object_data = &object_data;
+    draw_keys.push_back({key, (u32)render_list.size()});
+    render_list.push_back(renderable);
+  };
+
+  // The BVH skips subtrees that are fully outside and stops testing once a subtree is fully inside.
+  const auto record_render_list = [&](Mesh* mesh, bool inside) {
+    auto object = mesh->owner();
+
+    // Most objects are either fully inside or fully outside, which the bounding sphere detects cheaply.
+    // Only objects that intersect the frustum are tested more precisely using their bounding box.
+    if (inside) {
+      add_renderable({object, mesh, nullptr});
+    } else {
+      switch (camera_data.frustum.ClassifySphere(mesh->get_world_bounding_sphere())) {
+        case Frustum::Containment::Outside:
+          break;
+        case Frustum::Containment::Intersecting:
+          render_list_candidates.push_back({object, mesh, nullptr});
+          candidate_bounding_boxes.Push(mesh->get_world_bounding_box());
+          break;
+        case Frustum::Containment::Inside:
+          add_renderable({object, mesh, nullptr});
+          break;
       }
     }
-
-    for (auto child : object->children()) record_render_list(child);
   };
 
   if (!uploaded_example_cubemap) {
     CreateExampleCubeMap((VkCommandBuffer)command_buffers[0]->Handle());
+
+    auto& cube_entry = texture_cache[cubemap_handle];
+    frame_bind_group->Bind(1, cube_entry.texture, cube_entry.sampler, Texture::Layout::ShaderReadOnly);
     uploaded_example_cubemap = true;
   }
   
-  UpdateCamera(camera);
+  // Only recompute the matrices of transforms that changed and of their descendants.
+  statistics.transforms_updated = (u32)TransformSystem::get().update();
 
-  record_render_list(scene);
+  UpdateCamera(camera);
 
-  const auto comparator_lt = [](Renderable& a, Renderable& b) {
-    return a.z < b.z;
-  };
-  const auto comparator_gt = [](Renderable& a, Renderable& b) {
-    return a.z > b.z;
-  };
-  std::sort(render_list_opaque.begin(), render_list_opaque.end(), comparator_lt);
-  std::sort(render_list_transparent.begin(), render_list_transparent.end(), comparator_lt);
+  scene_bvh.Update(scene);
+  scene_bvh.CullFrustum(camera_data.frustum, record_render_list);
 
-  command_buffers[1]->BeginRenderPass(render_target, render_pass);
+  candidate_visible_mask.resize(render_list_candidates.size());
+  camera_data.frustum.CullBoxes(candidate_bounding_boxes, candidate_visible_mask.data());
 
-  for (auto const& renderable : render_list_opaque) {
-    RenderObject(command_buffers, renderable.object, renderable.mesh);
+  for (size_t i = 0; i < render_list_candidates.size(); i++) {
+    if (candidate_visible_mask[i]) {
+      add_renderable(render_list_candidates[i]);
+    }
   }
 
-  for (auto const& renderable : render_list_transparent) {
-    RenderObject(command_buffers, renderable.object, renderable.mesh);
+  auto sort_start = std::chrono::steady_clock::now();
+
+  RadixSort(draw_keys, draw_keys_buffer, [](DrawKey const& draw_key) {
+    return draw_key.key;
+  });
+
+  statistics.sort_time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - sort_start).count();
+
+  // Consecutive draws often share a pipeline or geometry, so drop binds of state that is already bound.
+  auto command_buffer = StateCachingCommandBuffer{*command_buffers[1]};
+
+  command_buffer.BeginRenderPass(render_target, render_pass);
+
+  // All pipelines share one pipeline layout, so the frame set stays bound for the whole pass.
+  command_buffer.BindGraphicsBindGroup(k_frame_set, pipeline_layout, frame_bind_group);
+
+  PipelineData* last_pipeline = nullptr;
+  Material* last_material = nullptr;
+  Geometry* last_geometry = nullptr;
+
+  for (auto const& draw_key : draw_keys) {
+    auto& renderable = render_list[draw_key.renderable];
+    auto pipeline = renderable.object_data->pipeline;
+    auto material = renderable.mesh->get_material().get();
+    auto geometry = renderable.mesh->get_geometry().get();
+
+    // Draws are sorted by material, so the uniforms of each material are usually written
+    // and its set is usually bound once per frame.
+    if (material != last_material) {
+      auto& material_data = GetMaterialData(material);
+      auto& uniforms = material->get_uniforms();
+      auto material_offset = 0u;
+
+      if (uniforms.size() != 0) {
+        material_offset = uniform_ring_buffer->Write(uniforms.data(), uniforms.size());
+      }
+
+      command_buffer.BindGraphicsBindGroup(
+        k_material_set,
+        pipeline_layout,
+        material_data.bind_group,
+        ArrayView<u32 const>{&material_offset, 1}
+      );
+      statistics.material_changes++;
+    }
+
+    statistics.pipeline_changes += pipeline != last_pipeline ? 1 : 0;
+    statistics.geometry_changes += geometry != last_geometry ? 1 : 0;
+    last_pipeline = pipeline;
+    last_material = material;
+    last_geometry = geometry;
+
+    RenderObject(command_buffer, renderable);
   }
 
-  command_buffers[1]->EndRenderPass();
+  command_buffer.EndRenderPass();
+
+  uniform_ring_buffer->Flush();
+  statistics.uniform_bytes = (u32)uniform_ring_buffer->GetUsedSize();
+
+  statistics.draw_calls = (u32)render_list.size();
+  statistics.binds = command_buffer.GetBindCount();
+  statistics.binds_elided = command_buffer.GetElidedBindCount();
 }
 
 auto ForwardRenderPipeline::GetColorTexture() -> Texture* {
@@ -104,6 +192,36 @@ auto ForwardRenderPipeline::GetNormalTexture() -> Texture* {
   return normal_texture.get();
 }
 
+auto ForwardRenderPipeline::GetStatistics() const -> RenderStatistics const& {
+  return statistics;
+}
+
+auto ForwardRenderPipeline::GetSceneBVH() -> SceneBVH& {
+  return scene_bvh;
+}
+
+bool ForwardRenderPipeline::PipelineKey::operator==(PipelineKey const& other) const {
+  return program == other.program &&
+         side == other.side &&
+         blend_state == other.blend_state &&
+         vertex_layout == other.vertex_layout;
+}
+
+auto ForwardRenderPipeline::PipelineKeyHash::operator()(PipelineKey const& key) const noexcept -> size_t {
+  auto hash = pair_hash{}(key.program);
+
+  const auto combine = [&](size_t value) {
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+
+  combine((size_t)key.side);
+  combine((size_t)key.blend_state.enable);
+
+  for (auto value : key.vertex_layout) combine(value);
+
+  return hash;
+}
+
 void ForwardRenderPipeline::CreateCameraUniformBlock() {
   auto layout = UniformBlockLayout{};
   layout.add<Matrix4>("projection");
@@ -174,30 +292,44 @@ void ForwardRenderPipeline::CreateRenderTarget() {
 }
 
 void ForwardRenderPipeline::CreateBindGroupAndPipelineLayout() {
-  auto bindings = std::vector<BindGroupLayout::Entry>{
+  // Set 0: camera and environment map, shared by all draws of a frame.
+  frame_bind_group_layout = render_device->CreateBindGroupLayout({
     {
       .binding = 0,
       .type = BindGroupLayout::Entry::Type::UniformBuffer
     },
     {
       .binding = 1,
-      .type = BindGroupLayout::Entry::Type::UniformBuffer
-    },
+      .type = BindGroupLayout::Entry::Type::ImageWithSampler
+    }
+  });
+
+  // Set 1: material uniforms followed by the texture slots, shared by all draws of a material.
+  auto material_bindings = std::vector<BindGroupLayout::Entry>{
     {
-      .binding = 2,
-      .type = BindGroupLayout::Entry::Type::UniformBuffer
+      .binding = 0,
+      .type = BindGroupLayout::Entry::Type::UniformBufferDynamic
     }
   };
 
-  for (int i = 0; i < 32; i++) {
-    bindings.push_back({
-      .binding = (u32)bindings.size(),
+  for (size_t i = 0; i < k_max_material_textures; i++) {
+    material_bindings.push_back({
+      .binding = (u32)material_bindings.size(),
       .type = BindGroupLayout::Entry::Type::ImageWithSampler
-      });
+    });
   }
 
-  bind_group_layout = render_device->CreateBindGroupLayout(bindings);
-  pipeline_layout = render_device->CreatePipelineLayout({bind_group_layout});
+  material_bind_group_layout = render_device->CreateBindGroupLayout(material_bindings);
+
+  frame_bind_group = frame_bind_group_layout->Instantiate();
+  frame_bind_group->Bind(0, camera_data.ubo, BindGroupLayout::Entry::Type::UniformBuffer);
+
+  // Per-draw data that materials request through Material::DrawData is pushed instead of bound.
+  pipeline_layout = render_device->CreatePipelineLayout({frame_bind_group_layout, material_bind_group_layout}, {{
+    .stages = k_draw_data_stages,
+    .offset = 0,
+    .size = k_draw_data_max_size
+  }});
 }
 
 auto ForwardRenderPipeline::CreatePipeline(
@@ -279,113 +411,178 @@ void ForwardRenderPipeline::CreateExampleCubeMap(VkCommandBuffer command_buffer)
   cubemap_handle = textures[0].get();
 }
 
-void ForwardRenderPipeline::RenderObject(
-  std::array<std::unique_ptr<CommandBuffer>, 2>& command_buffers,
-  GameObject* object,
-  Mesh* mesh
-) {
-  auto& geometry = mesh->geometry;
-  auto& material = mesh->material;
-
-  auto& geometry_data = geometry_cache->Get(geometry);
-
-  auto& object_data = object_cache[object];
+auto ForwardRenderPipeline::GetObjectData(Mesh* mesh) -> ObjectData& {
+  auto& object_data = object_cache[mesh];
 
-  if (!object_data.valid) {
-    object_data.bind_group = bind_group_layout->Instantiate();
-    object_data.bind_group->Bind(0, camera_data.ubo, BindGroupLayout::Entry::Type::UniformBuffer);
+  // The mesh is flagged for an update when its geometry or material was replaced, which invalidates the pipeline.
+  if (!object_data.valid || mesh->needs_update()) {
+    auto& geometry = mesh->get_geometry();
+    auto& material = mesh->get_material();
 
-    // Create some dummy uniform buffer and bind it to the bind group
-    object_data.ubo = render_device->CreateBuffer(Buffer::Usage::UniformBuffer, sizeof(Matrix4));
-    object_data.bind_group->Bind(1, object_data.ubo, BindGroupLayout::Entry::Type::UniformBuffer);
+    if (!object_data.valid) {
+      mesh->add_release_callback([this, mesh]() {
+        object_cache.erase(mesh);
+      });
+    }
 
     // Create shader modules
     auto program_key = ProgramKey{typeid(*material), material->get_compile_options()};
     if (program_cache.find(program_key) == program_cache.end()) {
       CompileShaderProgram(material);
     }
-    auto& program_data = program_cache[program_key];
-
-    // Create pipeline
-    object_data.pipeline = CreatePipeline(
-      geometry,
-      material,
-      pipeline_layout,
-      program_data.shader_vert,
-      program_data.shader_frag
-    );
 
+    // Find or create a pipeline, which is shared by all meshes with the same state.
+    auto pipeline_key = PipelineKey{program_key, material->side(), material->blend_state, {}};
+
+    for (auto& buffer : geometry->get_vertex_buffers()) {
+      pipeline_key.vertex_layout.push_back(buffer->stride());
+    }
+
+    for (auto const& attribute : geometry->get_attributes()) {
+      pipeline_key.vertex_layout.insert(pipeline_key.vertex_layout.end(), {
+        attribute.location, attribute.buffer, attribute.offset,
+        (size_t)attribute.data_type, attribute.components, (size_t)attribute.normalized});
+    }
+
+    auto match = pipeline_cache.find(pipeline_key);
+
+    if (match == pipeline_cache.end()) {
+      auto& program_data = program_cache[program_key];
+      auto pipeline = CreatePipeline(
+        geometry,
+        material,
+        pipeline_layout,
+        program_data.shader_vert,
+        program_data.shader_frag
+      );
+
+      match = pipeline_cache.emplace(pipeline_key, PipelineData{std::move(pipeline), (u32)pipeline_cache.size()}).first;
+    }
+
+    object_data.pipeline = &match->second;
     object_data.valid = true;
+    mesh->needs_update() = false;
   }
 
-  // Update object transform UBO
-  object_data.ubo->Update(&object->transform().world());
+  return object_data;
+}
+
+auto ForwardRenderPipeline::GetMaterialData(Material* material) -> MaterialData& {
+  auto& material_data = material_cache[material];
+
+  if (!material_data.bind_group) {
+    material->add_release_callback([this, material]() {
+      material_cache.erase(material);
+    });
+
+    // The uniforms are written to the ring buffer each frame
+    // and located through a dynamic offset when the bind group is bound.
+    // Materials without uniforms leave the binding unwritten, since a range of zero bytes is invalid.
+    // Their shaders must not declare the block, and the binding still takes a dynamic offset (of zero).
+    material_data.bind_group = material_bind_group_layout->Instantiate();
+
+    if (auto uniforms_size = material->get_uniforms().size(); uniforms_size != 0) {
+      material_data.bind_group->Bind(
+        0,
+        uniform_ring_buffer->GetBuffer(),
+        BindGroupLayout::Entry::Type::UniformBufferDynamic,
+        0,
+        uniforms_size
+      );
+    }
+  }
 
   auto texture_slots = material->get_texture_slots();
 
-  for (int i = 0; i < texture_slots.size(); i++) {
+  Assert(texture_slots.size() <= k_max_material_textures,
+    "ForwardRenderPipeline: materials are limited to {} textures", k_max_material_textures);
+
+  auto bound_slot_count = material_data.textures.size();
+
+  material_data.textures.resize(texture_slots.size(), nullptr);
+
+  // Only update the descriptors of slots that are new or whose texture was replaced.
+  // Empty slots are bound to a fallback texture, so that they do not keep sampling the texture they had before.
+  for (size_t i = 0; i < texture_slots.size(); i++) {
     auto& texture = texture_slots[i];
 
-    if (texture) {
-      auto& entry = texture_cache_->Get(texture);
+    if (i >= bound_slot_count || texture.get() != material_data.textures[i]) {
+      auto& entry = texture ? texture_cache_->Get(texture) : texture_cache_->GetFallback();
 
-      object_data.bind_group->Bind(3 + i, entry.texture, entry.sampler, Texture::Layout::ShaderReadOnly);
+      material_data.bind_group->Bind(1 + i, entry.texture, entry.sampler, Texture::Layout::ShaderReadOnly);
     }
+
+    material_data.textures[i] = texture.get();
   }
 
-  auto& cube_entry = texture_cache[cubemap_handle];
-  object_data.bind_group->Bind(34, cube_entry.texture, cube_entry.sampler, Texture::Layout::ShaderReadOnly);
+  return material_data;
+}
+
+void ForwardRenderPipeline::RenderObject(
+  CommandBuffer& command_buffer,
+  Renderable const& renderable
+) {
+  auto object = renderable.object;
+  auto& object_data = *renderable.object_data;
+  auto& geometry = renderable.mesh->get_geometry();
+  auto& material = renderable.mesh->get_material();
 
-  // Update and bind material UBO
-  auto& uniforms = material->get_uniforms();
-  if (material_ubo.find(material.get()) == material_ubo.end()) {
-    material_ubo[material.get()] = render_device->CreateBuffer(Buffer::Usage::UniformBuffer, uniforms.size());
-  }
-  auto& ubo = material_ubo[material.get()];
-  ubo->Update(uniforms.data(), uniforms.size());
-  object_data.bind_group->Bind(2, ubo, BindGroupLayout::Entry::Type::UniformBuffer);
+  auto& geometry_data = geometry_cache->Get(geometry);
 
   auto& index_buffer = geometry->get_index_buffer();
 
-  command_buffers[1]->BindGraphicsPipeline(object_data.pipeline);
-  command_buffers[1]->BindGraphicsBindGroup(0, pipeline_layout, object_data.bind_group);
-  command_buffers[1]->BindIndexBuffer(geometry_data.ibo, index_buffer->data_type());
-  command_buffers[1]->BindVertexBuffers(ArrayView<std::shared_ptr<Buffer>>{
+  command_buffer.BindGraphicsPipeline(object_data.pipeline->pipeline);
+
+  auto draw_data = material->draw_data();
+
+  if (draw_data != Material::DrawData::None) {
+    u8 data[k_draw_data_max_size];
+    u32 size = 0;
+
+    if ((draw_data & Material::DrawData::ModelMatrix) != Material::DrawData::None) {
+      std::memcpy(data + size, &object->transform().world(), sizeof(Matrix4));
+      size += sizeof(Matrix4);
+    }
+
+    command_buffer.PushConstants(pipeline_layout, k_draw_data_stages, 0, size, data);
+  }
+
+  command_buffer.BindIndexBuffer(geometry_data.ibo, index_buffer->data_type());
+  command_buffer.BindVertexBuffers(ArrayView<std::shared_ptr<Buffer>>{
     (std::shared_ptr<Buffer>*)geometry_data.vbos.data(), geometry_data.vbos.size()});
 
   switch (index_buffer->data_type()) {
     case IndexDataType::UInt16:
-      command_buffers[1]->DrawIndexed(index_buffer->size() / sizeof(u16));
+      command_buffer.DrawIndexed(index_buffer->size() / sizeof(u16));
       break;
     case IndexDataType::UInt32:
-      command_buffers[1]->DrawIndexed(index_buffer->size() / sizeof(u32));
+      command_buffer.DrawIndexed(index_buffer->size() / sizeof(u32));
       break;
   }
 }
 
-bool ForwardRenderPipeline::IsObjectInsideCameraFrustum(Matrix4 const& modelview, std::shared_ptr<Geometry> const& geometry) {
-  auto aabb = geometry->get_bounding_box().ApplyMatrix(modelview);
-
-  return camera_data.frustum->ContainsBox(aabb);
-}
-
 void ForwardRenderPipeline::UpdateCamera(GameObject* camera) {
+  auto depth_range = Frustum::DepthRange::ZeroToOne;
+
   // TODO: add support for filters and component inheritance to our component system.  
   if (camera->has_component<PerspectiveCamera>()) {
     auto camera_component = camera->get_component<PerspectiveCamera>();
 
     *camera_data.projection = camera_component->get_projection();
-    camera_data.frustum = &camera_component->get_frustum();
   } else if (camera->has_component<OrthographicCamera>()) {
     auto camera_component = camera->get_component<OrthographicCamera>();
 
     *camera_data.projection = camera_component->get_projection();
-    camera_data.frustum = &camera_component->get_frustum();
+
+    // TODO: OrthographicCamera still uses the OpenGL depth range.
+    depth_range = Frustum::DepthRange::NegativeOneToOne;
   } else {
     Assert(false, "Renderer: camera does not hold a camera component");
   }
 
-  *camera_data.view = camera->transform().world().Inverse();
+  *camera_data.view = camera->transform().world_inverse();
+
+  camera_data.frustum = Frustum::FromMatrix(*camera_data.projection * *camera_data.view, depth_range);
 
   camera_data.ubo->Update(camera_data.data.data(), camera_data.data.size());
 }
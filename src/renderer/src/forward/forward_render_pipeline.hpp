@@ -4,20 +4,24 @@
 #pragma once
 
 #include <aurora/gal/render_device.hpp>
+#include <aurora/math/box3_array.hpp>
 #include <aurora/renderer/component/camera.hpp>
 #include <aurora/renderer/component/mesh.hpp>
 #include <aurora/renderer/material.hpp>
+#include <aurora/renderer/scene_bvh.hpp>
 #include <aurora/renderer/texture.hpp>
 #include <aurora/renderer/uniform_block.hpp>
 #include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 #include <vulkan/vulkan.h>
 
 #include "cache/geometry_cache.hpp"
 #include "cache/texture_cache.hpp"
 #include "render_pipeline_base.hpp"
+#include "uniform_ring_buffer.hpp"
 
 namespace Aura {
 
@@ -37,19 +41,62 @@ struct ForwardRenderPipeline final : RenderPipelineBase {
   auto GetColorTexture() -> Texture* override;
   auto GetDepthTexture() -> Texture* override;
   auto GetNormalTexture() -> Texture* override;
+  auto GetStatistics() const -> RenderStatistics const& override;
+  auto GetSceneBVH() -> SceneBVH& override;
 
 private:
   using ProgramKey = std::pair<std::type_index, u32>;
 
+  // Enough for 32k material runs with 256-byte uniform alignment.
+  static constexpr size_t k_uniform_ring_buffer_frame_size = 8 * 1024 * 1024;
+
+  // Descriptor sets ordered by update frequency. Per-draw data is passed through push constants.
+  static constexpr u32 k_frame_set = 0;
+  static constexpr u32 k_material_set = 1;
+
+  static constexpr size_t k_max_material_textures = 32;
+
+  // Large enough for all values of Material::DrawData and within the 128 bytes that every device supports.
+  static constexpr u32 k_draw_data_max_size = sizeof(Matrix4);
+  static constexpr auto k_draw_data_stages = BindGroupLayout::Entry::ShaderStage::Vertex |
+                                             BindGroupLayout::Entry::ShaderStage::Fragment;
+
+  /**
+   * Describes all state that goes into a pipeline, so that meshes with equal state share a pipeline.
+   */
+  struct PipelineKey {
+    ProgramKey program;
+    Material::Side side;
+    Material::BlendState blend_state;
+    std::vector<size_t> vertex_layout; /**< the stride of each vertex buffer followed by the fields of each attribute */
+
+    bool operator==(PipelineKey const& other) const;
+  };
+
+  struct PipelineKeyHash {
+    auto operator()(PipelineKey const& key) const noexcept -> size_t;
+  };
+
+  struct ObjectData;
+  struct MaterialData;
+
   struct Renderable {
     GameObject* object;
     Mesh* mesh;
-    float z;
+    ObjectData* object_data;
+  };
+
+  // Sorting small key-index pairs instead of the renderables themselves halves the memory traffic of the radix sort.
+  struct DrawKey {
+    u64 key; /**< see {@link #SortKey} */
+    u32 renderable; /**< the index into the render list */
   };
 
   void CreateCameraUniformBlock();
   void CreateRenderTarget();
   void CreateBindGroupAndPipelineLayout();
+  auto GetObjectData(Mesh* mesh) -> ObjectData&;
+  auto GetMaterialData(Material* material) -> MaterialData&;
   auto CreatePipeline(
     AnyPtr<Geometry> geometry,
     AnyPtr<Material> material,
@@ -61,13 +108,10 @@ private:
   void CreateExampleCubeMap(VkCommandBuffer command_buffer);
 
   void RenderObject(
-    std::array<std::unique_ptr<CommandBuffer>, 2>& command_buffers,
-    GameObject* object,
-    Mesh* mesh
+    CommandBuffer& command_buffer,
+    Renderable const& renderable
   );
 
-  bool IsObjectInsideCameraFrustum(Matrix4 const& modelview, std::shared_ptr<Geometry> const& geometry);
-
   void UpdateCamera(GameObject* camera);
 
   void CompileShaderProgram(AnyPtr<Material> material);
@@ -96,9 +140,22 @@ private:
     Matrix4* view;
     std::unique_ptr<Buffer> ubo;
 
-    Frustum const* frustum;
+    Frustum frustum; /**< world-space frustum */
   } camera_data;
 
+  // Frustum culling
+  SceneBVH scene_bvh;
+  std::vector<Renderable> render_list_candidates;
+  Box3Array candidate_bounding_boxes;
+  std::vector<u8> candidate_visible_mask;
+
+  // Render list and the order in which it is drawn
+  std::vector<Renderable> render_list;
+  std::vector<DrawKey> draw_keys;
+  std::vector<DrawKey> draw_keys_buffer;
+
+  RenderStatistics statistics;
+
   std::shared_ptr<RenderDevice> render_device;
 
   // Caches
@@ -111,20 +168,28 @@ private:
     std::unique_ptr<Sampler> sampler;
     std::unique_ptr<Buffer> buffer;
   };
+  struct PipelineData {
+    std::unique_ptr<GraphicsPipeline> pipeline;
+    u32 id; /**< dense identifier used in sort keys */
+  };
   struct ObjectData {
     bool valid = false;
-
-    // TODO: move this stuff to the appropriate places.
+    PipelineData* pipeline;
+  };
+  struct MaterialData {
     std::unique_ptr<BindGroup> bind_group;
-    std::unique_ptr<Buffer> ubo;
-    std::unique_ptr<GraphicsPipeline> pipeline;
+    std::vector<Texture2D*> textures; /**< the textures that are bound to the bind group */
   };
   std::shared_ptr<GeometryCache> geometry_cache;
   std::shared_ptr<TextureCache> texture_cache_;
   std::unordered_map<ProgramKey, ProgramData, pair_hash> program_cache;
+  std::unordered_map<PipelineKey, PipelineData, PipelineKeyHash> pipeline_cache;
   std::unordered_map<Texture2D*, TextureData> texture_cache;
-  std::unordered_map<GameObject*, ObjectData> object_cache;
-  std::unordered_map<Material*, std::unique_ptr<Buffer>> material_ubo;
+  std::unordered_map<Mesh*, ObjectData> object_cache;
+  std::unordered_map<Material*, MaterialData> material_cache;
+
+  // Per-frame material uniforms
+  std::unique_ptr<UniformRingBuffer> uniform_ring_buffer;
 
   // Render target and pass
   std::shared_ptr<Texture> color_texture;
@@ -134,8 +199,10 @@ private:
   std::unique_ptr<RenderTarget> render_target;
   std::shared_ptr<RenderPass> render_pass;
 
-  // Bind group and pipeline layout
-  std::shared_ptr<BindGroupLayout> bind_group_layout;
+  // Bind groups and pipeline layout
+  std::shared_ptr<BindGroupLayout> frame_bind_group_layout;
+  std::shared_ptr<BindGroupLayout> material_bind_group_layout;
+  std::unique_ptr<BindGroup> frame_bind_group;
   std::shared_ptr<PipelineLayout> pipeline_layout;
 
   // Example cubemap
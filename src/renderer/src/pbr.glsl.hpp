@@ -11,12 +11,12 @@ constexpr auto pbr_vert = R"(
   layout (location = 2) in vec2 a_uv;
   layout (location = 3) in vec3 a_color;
 
-  layout (binding = 0, std140) uniform Camera {
+  layout (set = 0, binding = 0, std140) uniform Camera {
     mat4 u_projection;
     mat4 u_view;
   };
 
-  layout (binding = 1, std140) uniform Material {
+  layout (push_constant) uniform Draw {
     mat4 u_model;
   };
 
@@ -137,27 +137,22 @@ constexpr auto pbr_frag = R"(
   layout(location = 4) in vec2 v_uv;
   layout(location = 5) in vec3 v_normal;
 
-  layout (binding = 0, std140) uniform Camera {
+  layout (set = 0, binding = 0, std140) uniform Camera {
     mat4 u_projection;
     mat4 u_view;
   };
 
-  layout (binding = 1, std140) uniform Object {
-    mat4 u_model;
-  };
-
-  layout (binding = 2, std140) uniform Material {
-    mat4 u_dummy; // remove me, for OGL compat.
+  layout (set = 1, binding = 0, std140) uniform Material {
     float u_metalness;
     float u_roughness;
   };
 
-  layout (binding = 3) uniform sampler2D u_diffuse_map;
-  layout (binding = 4) uniform sampler2D u_metalness_map;
-  layout (binding = 5) uniform sampler2D u_roughness_map;
-  layout (binding = 6) uniform sampler2D u_normal_map;
+  layout (set = 1, binding = 1) uniform sampler2D u_diffuse_map;
+  layout (set = 1, binding = 2) uniform sampler2D u_metalness_map;
+  layout (set = 1, binding = 3) uniform sampler2D u_roughness_map;
+  layout (set = 1, binding = 4) uniform sampler2D u_normal_map;
 
-  layout (binding = 34) uniform samplerCube u_env_map;
+  layout (set = 0, binding = 1) uniform samplerCube u_env_map;
 
   // Source: https://knarkowicz.wordpress.com/2016/01/06/aces-filmic-tone-mapping-curve/
   vec3 ACESFilm(vec3 x) {
@@ -46,6 +46,14 @@ struct RenderEngine final : RenderEngineBase {
     return render_texture.get();
   }
 
+  auto GetStatistics() const -> RenderStatistics const& override {
+    return render_pipeline->GetStatistics();
+  }
+
+  auto GetSceneBVH() -> SceneBVH& override {
+    return render_pipeline->GetSceneBVH();
+  }
+
 private:
   void CreateSharedCaches() {
     geometry_cache = std::make_shared<GeometryCache>(render_device);
@@ -5,6 +5,8 @@
 
 #include <array>
 #include <aurora/gal/command_buffer.hpp>
+#include <aurora/renderer/scene_bvh.hpp>
+#include <aurora/renderer/render_statistics.hpp>
 #include <aurora/scene/game_object.hpp>
 #include <aurora/gal/texture.hpp>
 #include <memory>
@@ -23,6 +25,8 @@ struct RenderPipelineBase {
   virtual auto GetColorTexture() -> Texture* = 0;
   virtual auto GetDepthTexture() -> Texture* = 0;
   virtual auto GetNormalTexture() -> Texture* = 0;
+  virtual auto GetStatistics() const -> RenderStatistics const& = 0;
+  virtual auto GetSceneBVH() -> SceneBVH& = 0;
 };
 
 } // namespace Aura
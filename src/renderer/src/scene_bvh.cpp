@@ -0,0 +1,232 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/renderer/scene_bvh.hpp>
+#include <aurora/scene/transform_system.hpp>
+
+namespace Aura {
+
+void SceneBVH::Update(GameObject* scene) {
+  auto& transform_system = TransformSystem::get();
+  auto update_count = transform_system.update_count();
+
+  if (scene != this->scene) {
+    Build(scene);
+  } else if (update_count == transform_update_count + 1) {
+    for (auto id : transform_system.changed_ids()) {
+      if (id < entries.size() && entries[id].proxy != BVH::k_null) {
+        UpdateMesh(entries[id]);
+      }
+    }
+  } else if (update_count != transform_update_count) {
+    // The changes of at least one update were missed, so refresh every mesh.
+    for (auto& entry : entries) {
+      if (entry.proxy != BVH::k_null) {
+        UpdateMesh(entry);
+      }
+    }
+  }
+
+  // Geometries are edited rarely, so only look for the meshes of edited geometries after any geometry was edited.
+  if (Geometry::get_global_version() != geometry_global_version) {
+    for (auto& entry : entries) {
+      if (entry.proxy != BVH::k_null && entry.geometry_version != entry.mesh->get_geometry()->get_version()) {
+        UpdateMesh(entry);
+      }
+    }
+  }
+
+  transform_update_count = update_count;
+  geometry_global_version = Geometry::get_global_version();
+
+  if (bvh.Cost() > rebuild_cost * k_rebuild_cost_factor) {
+    Rebuild();
+  }
+}
+
+void SceneBVH::on_child_added(GameObject* parent, GameObject* child) {
+  if (IsInScene(parent) && parent->visible_in_hierarchy()) {
+    AddSubtree(child);
+  }
+}
+
+void SceneBVH::on_child_removed(GameObject* /*parent*/, GameObject* child) {
+  RemoveSubtree(child);
+}
+
+void SceneBVH::on_component_added(GameObject* object, Component* component) {
+  if (component == object->get_component<Mesh>() && IsInScene(object) && object->visible_in_hierarchy()) {
+    AddMesh(object);
+  }
+}
+
+void SceneBVH::on_component_removed(GameObject* object, Component* component) {
+  if (component == object->get_component<Mesh>()) {
+    RemoveMesh(object);
+  }
+}
+
+void SceneBVH::on_component_changed(GameObject* object, Component* component) {
+  if (component == object->get_component<Mesh>()) {
+    // The geometry might have changed, so the bounding box has to be reinserted.
+    RemoveMesh(object);
+
+    if (IsInScene(object) && object->visible_in_hierarchy()) {
+      AddMesh(object);
+    }
+  }
+}
+
+void SceneBVH::on_visibility_changed(GameObject* object) {
+  if (!IsInScene(object)) {
+    return;
+  }
+
+  if (object->visible_in_hierarchy()) {
+    AddSubtree(object);
+  } else {
+    RemoveSubtree(object);
+  }
+}
+
+void SceneBVH::on_destroyed(GameObject* object) {
+  if (object == scene) {
+    bvh.Clear();
+    entries.clear();
+    mesh_count = 0;
+    scene = nullptr;
+  } else {
+    RemoveMesh(object);
+  }
+}
+
+bool SceneBVH::IsInScene(GameObject* object) const {
+  if (scene == nullptr) {
+    return false;
+  }
+
+  while (object->has_parent()) {
+    object = object->parent();
+  }
+  return object == scene;
+}
+
+bool SceneBVH::IsRenderable(GameObject* object) const {
+  auto mesh = object->get_component<Mesh>();
+
+  return mesh && mesh->visible() && mesh->get_geometry();
+}
+
+void SceneBVH::AddSubtree(GameObject* object) {
+  std::vector<GameObject*> stack{object};
+
+  while (!stack.empty()) {
+    auto object = stack.back();
+
+    stack.pop_back();
+
+    // Invisible objects hide their whole subtree.
+    if (object->visible()) {
+      AddMesh(object);
+      stack.insert(stack.end(), object->children().begin(), object->children().end());
+    }
+  }
+}
+
+void SceneBVH::RemoveSubtree(GameObject* object) {
+  std::vector<GameObject*> stack{object};
+
+  while (!stack.empty()) {
+    auto object = stack.back();
+
+    stack.pop_back();
+    RemoveMesh(object);
+    stack.insert(stack.end(), object->children().begin(), object->children().end());
+  }
+}
+
+void SceneBVH::AddMesh(GameObject* object) {
+  if (!IsRenderable(object)) {
+    return;
+  }
+
+  auto id = object->transform().id();
+
+  if (entries.size() <= id) {
+    entries.resize(id + 1);
+  }
+
+  auto& entry = entries[id];
+
+  if (entry.proxy == BVH::k_null) {
+    entry.mesh = object->get_component<Mesh>();
+    entry.proxy = bvh.Insert(entry.mesh->get_world_bounding_box(), id);
+    entry.geometry_version = entry.mesh->get_geometry()->get_version();
+    mesh_count++;
+  }
+}
+
+void SceneBVH::RemoveMesh(GameObject* object) {
+  auto id = object->transform().id();
+
+  if (id < entries.size() && entries[id].proxy != BVH::k_null) {
+    bvh.Remove(entries[id].proxy);
+    entries[id] = {};
+    mesh_count--;
+  }
+}
+
+void SceneBVH::UpdateMesh(Entry& entry) {
+  bvh.Update(entry.proxy, entry.mesh->get_world_bounding_box());
+  entry.geometry_version = entry.mesh->get_geometry()->get_version();
+}
+
+void SceneBVH::Build(GameObject* scene) {
+  this->scene = scene;
+
+  entries.clear();
+  mesh_count = 0;
+
+  std::vector<Box3> boxes;
+  std::vector<u32> ids;
+  std::vector<GameObject*> stack{scene};
+
+  while (!stack.empty()) {
+    auto object = stack.back();
+
+    stack.pop_back();
+
+    if (!object->visible()) {
+      continue;
+    }
+
+    if (IsRenderable(object)) {
+      auto id = object->transform().id();
+
+      if (entries.size() <= id) {
+        entries.resize(id + 1);
+      }
+
+      // The proxy of each leaf of a bulk-built BVH is the index of its box.
+      auto mesh = object->get_component<Mesh>();
+
+      entries[id] = {mesh, (u32)boxes.size(), mesh->get_geometry()->get_version()};
+      boxes.push_back(entries[id].mesh->get_world_bounding_box());
+      ids.push_back(id);
+    }
+
+    stack.insert(stack.end(), object->children().begin(), object->children().end());
+  }
+
+  bvh.Build(boxes, ids);
+  mesh_count = boxes.size();
+  rebuild_cost = bvh.Cost();
+  rebuild_count++;
+}
+
+void SceneBVH::Rebuild() {
+  bvh.Rebuild();
+  rebuild_cost = bvh.Cost();
+  rebuild_count++;
+}
+
+} // namespace Aura
@@ -0,0 +1,140 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/renderer/scene_query.hpp>
+#include <algorithm>
+
+namespace Aura {
+
+template<typename Test, typename Visit>
+void SceneQuery::QueryMeshes(Test&& test, Visit&& visit) {
+  scene_bvh.Update(scene);
+
+  auto& bvh = scene_bvh.GetBVH();
+
+  bvh.Query(test, [&](u32 proxy) {
+    visit(scene_bvh.GetMesh(bvh.GetItem(proxy)));
+  });
+}
+
+/**
+ * Find the meshes with triangles that intersect a world-space volume.
+ *
+ * @param bounds        the world-space bounding box of the volume
+ * @param center        the point that distances are measured from
+ * @param test_box      tests whether a world-space bounding box intersects the volume
+ * @param test_triangle tests whether a world-space triangle intersects the volume
+ */
+template<typename TestBox, typename TestTriangle>
+auto SceneQuery::Overlap(
+  Box3 const& bounds,
+  Vector3 const& center,
+  TestBox&& test_box,
+  TestTriangle&& test_triangle
+) -> std::vector<Hit> {
+  std::vector<Hit> hits;
+
+  QueryMeshes(test_box, [&](Mesh* mesh) {
+    auto& geometry = *mesh->get_geometry();
+    auto& triangle_bvh = geometry.get_triangle_bvh();
+    auto triangles = geometry.get_triangles();
+    auto object = mesh->owner();
+    auto& world = object->transform().world();
+
+    if (!triangles) {
+      return;
+    }
+
+    // Find candidate triangles by the object-space bounding box of the volume, then test them exactly in world space.
+    auto object_bounds = bounds.ApplyMatrix(object->transform().world_inverse());
+
+    std::optional<Hit> closest_hit;
+
+    const auto test_triangle_box = [&](Box3 const& box) {
+      return object_bounds.IntersectsBox(box);
+    };
+
+    triangle_bvh.Query(test_triangle_box, [&](u32 proxy) {
+      auto triangle = triangle_bvh.GetItem(proxy);
+      auto world_triangle = (*triangles)[triangle].ApplyMatrix(world);
+
+      if (!test_triangle(world_triangle)) {
+        return;
+      }
+
+      auto distance = (world_triangle.GetClosestPoint(center) - center).Length();
+
+      if (!closest_hit || distance < closest_hit->distance) {
+        closest_hit = Hit{object, mesh, distance, triangle};
+      }
+    });
+
+    if (closest_hit) {
+      hits.push_back(*closest_hit);
+    }
+  });
+
+  std::sort(hits.begin(), hits.end(), [](Hit const& a, Hit const& b) {
+    return a.distance < b.distance;
+  });
+
+  return hits;
+}
+
+auto SceneQuery::Raycast(Ray const& ray, float max_distance) -> std::optional<Hit> {
+  auto direction = ray.Direction();
+  auto world_ray = Ray{ray.Origin(), direction.Normalize()};
+
+  std::optional<Hit> closest_hit;
+
+  // The maximum distance shrinks with every hit, which prunes the remaining subtrees of both hierarchies.
+  const auto test = [&](Box3 const& box) {
+    return world_ray.IntersectsBox(box, max_distance);
+  };
+
+  QueryMeshes(test, [&](Mesh* mesh) {
+    auto& geometry = *mesh->get_geometry();
+    auto& triangle_bvh = geometry.get_triangle_bvh();
+    auto triangles = geometry.get_triangles();
+    auto object = mesh->owner();
+
+    if (!triangles) {
+      return;
+    }
+
+    // The ray parameter of a point does not change under the transform, so distances can be compared in object space.
+    auto object_ray = world_ray.ApplyMatrix(object->transform().world_inverse());
+
+    const auto test_triangle_box = [&](Box3 const& box) {
+      return object_ray.IntersectsBox(box, max_distance);
+    };
+
+    triangle_bvh.Query(test_triangle_box, [&](u32 proxy) {
+      auto triangle = triangle_bvh.GetItem(proxy);
+      auto t = object_ray.IntersectTriangle((*triangles)[triangle]);
+
+      if (t && *t <= max_distance) {
+        max_distance = *t;
+        closest_hit = Hit{object, mesh, *t, triangle};
+      }
+    });
+  });
+
+  return closest_hit;
+}
+
+auto SceneQuery::OverlapSphere(Sphere const& sphere) -> std::vector<Hit> {
+  auto& center = sphere.Center();
+  auto radius = sphere.Radius();
+
+  return Overlap(sphere.GetBoundingBox(), center,
+    [&](Box3 const& box) { return sphere.IntersectsBox(box); },
+    [&](Triangle const& triangle) { return (triangle.GetClosestPoint(center) - center).Length() <= radius; });
+}
+
+auto SceneQuery::OverlapBox(Box3 const& box) -> std::vector<Hit> {
+  return Overlap(box, box.Center(),
+    [&](Box3 const& other) { return box.IntersectsBox(other); },
+    [&](Triangle const& triangle) { return triangle.IntersectsBox(box); });
+}
+
+} // namespace Aura
@@ -0,0 +1,72 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/integer.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace Aura {
+
+/**
+ * Packs the state of a draw into a 64-bit key, so that sorting the keys in ascending order
+ * yields the order in which the draws should be submitted.
+ *
+ * Opaque draws are grouped by pipeline, material and geometry to minimize state changes
+ * and drawn front-to-back within each group:
+ *
+ *   | 63..62 layer | 61..48 pipeline | 47..32 material | 31..16 geometry | 15..0 depth |
+ *
+ * Transparent draws must be blended back-to-front, so depth takes precedence over state:
+ *
+ *   | 63..62 layer | 61..32 inverted depth | 31..18 pipeline | 17..2 material | 1..0 unused |
+ *
+ * Identifiers that do not fit into their field wrap around, which only affects how well draws are grouped.
+ */
+struct SortKey {
+  enum class Layer : u64 {
+    Opaque = 0,
+    Transparent = 1
+  };
+
+  static auto Opaque(u32 pipeline, u32 material, u32 geometry, float depth) -> u64 {
+    return (u64)Layer::Opaque << 62 |
+           (u64)(pipeline & 0x3FFF) << 48 |
+           (u64)(material & 0xFFFF) << 32 |
+           (u64)(geometry & 0xFFFF) << 16 |
+           (u64)(QuantizeDepth(depth) >> 15);
+  }
+
+  static auto Transparent(u32 pipeline, u32 material, float depth) -> u64 {
+    return (u64)Layer::Transparent << 62 |
+           (u64)(~QuantizeDepth(depth) >> 1 & 0x3FFFFFFF) << 32 |
+           (u64)(pipeline & 0x3FFF) << 18 |
+           (u64)(material & 0xFFFF) << 2;
+  }
+
+  /**
+   * Reduce a pointer to a small identifier for use in a sort key.
+   * Distinct pointers may map to the same identifier, which only affects how well draws are grouped.
+   */
+  static auto HashPointer(void const* pointer) -> u32 {
+    return (u32)(((uintptr_t)pointer >> 4) * 0x9E3779B97F4A7C15ull >> 48);
+  }
+
+private:
+  /**
+   * Map a view-space distance to an integer that increases monotonically with the distance.
+   * The bit pattern of a non-negative float has this property, which gives more precision close to the camera.
+   *
+   * @param depth the distance along the view direction
+   * @return the bit pattern of the distance clamped to zero, which uses the lower 31 bits
+   */
+  static auto QuantizeDepth(float depth) -> u32 {
+    u32 bits;
+
+    depth = depth > 0 ? depth : 0;
+    std::memcpy(&bits, &depth, sizeof(float));
+    return bits;
+  }
+};
+
+} // namespace Aura
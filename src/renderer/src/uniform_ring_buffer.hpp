@@ -0,0 +1,95 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/gal/render_device.hpp>
+#include <aurora/integer.hpp>
+#include <aurora/log.hpp>
+#include <cstring>
+#include <memory>
+
+namespace Aura {
+
+/**
+ * A linear allocator for uniform data that only lives for a single frame.
+ *
+ * One persistently mapped buffer is split into a region per frame. Data is written straight into the region
+ * of the current frame, so no copy commands are recorded, and is accessed from shaders through
+ * {@link #BindGroupLayout::Entry::Type::UniformBufferDynamic} bindings with the returned offsets.
+ *
+ * A region is reused `frame_count` frames later, so at most `frame_count - 1` earlier frames
+ * may still be executing on the GPU when a new frame begins.
+ */
+struct UniformRingBuffer {
+  UniformRingBuffer(
+    std::shared_ptr<RenderDevice> const& render_device,
+    size_t frame_size,
+    u32 frame_count = 2
+  )   : frame_size(frame_size)
+      , frame_count(frame_count)
+      , alignment(render_device->UniformBufferOffsetAlignment()) {
+    buffer = render_device->CreateMappedBuffer(Buffer::Usage::UniformBuffer, frame_size * frame_count);
+  }
+
+  /**
+   * Begin allocating from the region of the next frame. Must be called once at the start of each frame.
+   */
+  void NextFrame() {
+    frame = (frame + 1) % frame_count;
+    used = 0;
+  }
+
+  /**
+   * Make the data written during the current frame visible to the GPU.
+   * Must be called after the last allocation of the frame and before the frame is submitted.
+   */
+  void Flush() {
+    if (used > 0) {
+      buffer->Flush(frame * frame_size, used);
+    }
+  }
+
+  /**
+   * Allocate memory for the current frame and copy data into it.
+   *
+   * @param data the data
+   * @param size the size of the data in bytes
+   * @return the offset of the data in the buffer, to be passed as a dynamic offset
+   */
+  auto Write(void const* data, size_t size) -> u32 {
+    auto offset = (used + alignment - 1) / alignment * alignment;
+
+    Assert(offset + size <= frame_size, "UniformRingBuffer: out of memory for the current frame, size={}", frame_size);
+
+    used = offset + size;
+    offset += frame * frame_size;
+    std::memcpy((u8*)buffer->Data() + offset, data, size);
+    return (u32)offset;
+  }
+
+  template<typename T>
+  auto Write(T const& value) -> u32 {
+    return Write(&value, sizeof(T));
+  }
+
+  auto GetBuffer() -> std::unique_ptr<Buffer>& {
+    return buffer;
+  }
+
+  /**
+   * Get the number of bytes that were allocated during the current frame, including alignment padding.
+   */
+  auto GetUsedSize() const -> size_t {
+    return used;
+  }
+
+private:
+  std::unique_ptr<Buffer> buffer;
+  size_t frame_size;
+  u32 frame_count;
+  size_t alignment;
+  u32 frame = 0;
+  size_t used = 0;
+};
+
+} // namespace Aura
@@ -0,0 +1,343 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/math/box3.hpp>
+#include <aurora/math/quaternion.hpp>
+#include <aurora/scene/game_object.hpp>
+#include <aurora/scene/rotation.hpp>
+#include <aurora/integer.hpp>
+#include <aurora/job_system.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+using namespace Aura;
+
+/**
+ * Aurora-Scene-Bench measures rotations, component lookup, GameObject creation and destruction and transform updates.
+ *
+ * A human-readable table is printed to stderr and the results are written as JSON to stdout:
+ *
+ *   {
+ *     "compiler": "...",
+ *     "simd": "avx" | "sse" | "scalar",
+ *     "results": [
+ *       { "name": "...", "batch_size": 10000, "ns_per_op": 1.23, "ops_per_second": 8.1e8 },
+ *       ...
+ *     ]
+ *   }
+ *
+ * Pass a substring as the first argument to only run the benchmarks whose name contains it.
+ */
+
+struct Result {
+  std::string name;
+  size_t batch_size;
+  double ns_per_op;
+  double ops_per_second;
+};
+
+static volatile u32 g_sink;
+static char const* g_filter = nullptr;
+static std::vector<Result> g_results;
+
+/**
+ * Run a benchmark and record the average time per operation.
+ *
+ * @param name        name of the benchmark
+ * @param batch_size  number of operations performed by a single invocation of `function`
+ * @param function    the benchmarked code
+ */
+static void Run(char const* name, size_t batch_size, std::function<void()> const& function) {
+  using clock = std::chrono::steady_clock;
+
+  if (g_filter && !std::strstr(name, g_filter)) {
+    return;
+  }
+
+  // Warm up caches and find an iteration count that runs for roughly 0.25 seconds.
+  size_t iterations = 1;
+
+  while (true) {
+    auto t0 = clock::now();
+    for (size_t i = 0; i < iterations; i++) function();
+    auto elapsed = std::chrono::duration<double>(clock::now() - t0).count();
+
+    if (elapsed >= 0.25) {
+      auto ns_per_op = elapsed * 1e9 / (double)(iterations * batch_size);
+
+      g_results.push_back({name, batch_size, ns_per_op, 1e9 / ns_per_op});
+      std::fprintf(stderr, "%-40s %8zu %10.3f ns/op %12.3f Mop/s\n", name, batch_size, ns_per_op, 1e3 / ns_per_op);
+      break;
+    }
+
+    iterations *= 2;
+  }
+}
+
+static void WriteJSON() {
+#if defined(__clang__)
+  auto compiler = std::string{"clang "} + __clang_version__;
+#elif defined(__GNUC__)
+  auto compiler = std::string{"gcc "} + __VERSION__;
+#elif defined(_MSC_VER)
+  auto compiler = std::string{"msvc "} + std::to_string(_MSC_VER);
+#else
+  auto compiler = std::string{"unknown"};
+#endif
+
+#if defined(AURA_MATH_AVX)
+  auto simd = "avx";
+#elif defined(AURA_MATH_SSE)
+  auto simd = "sse";
+#else
+  auto simd = "scalar";
+#endif
+
+  std::printf("{\n");
+  std::printf("  \"compiler\": \"%s\",\n", compiler.c_str());
+  std::printf("  \"simd\": \"%s\",\n", simd);
+  std::printf("  \"results\": [\n");
+
+  for (size_t i = 0; i < g_results.size(); i++) {
+    auto& result = g_results[i];
+
+    std::printf(
+      "    { \"name\": \"%s\", \"batch_size\": %zu, \"ns_per_op\": %.4f, \"ops_per_second\": %.1f }%s\n",
+      result.name.c_str(),
+      result.batch_size,
+      result.ns_per_op,
+      result.ops_per_second,
+      i + 1 < g_results.size() ? "," : ""
+    );
+  }
+
+  std::printf("  ]\n");
+  std::printf("}\n");
+}
+
+static auto g_rng = std::mt19937{};
+
+static auto RandomFloat(float min = -1, float max = 1) -> float {
+  return std::uniform_real_distribution<float>{min, max}(g_rng);
+}
+
+static auto RandomVector3() -> Vector3 {
+  return Vector3{RandomFloat(), RandomFloat(), RandomFloat()};
+}
+
+static auto RandomQuaternion() -> Quaternion {
+  auto quat = Quaternion{RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat()};
+  quat.Normalize();
+  return quat;
+}
+
+/**
+ * Call a function for the thread counts from one up to the number of hardware threads, doubling the count each time.
+ * The number of hardware threads is always included.
+ */
+static void ForEachThreadCount(std::function<void(u32)> const& function) {
+  auto max_thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (u32 thread_count = 1; thread_count < max_thread_count; thread_count *= 2) {
+    function(thread_count);
+  }
+
+  function(max_thread_count);
+}
+
+static void BenchmarkRotations() {
+  constexpr size_t k_count = 10000;
+
+  std::vector<Vector3> eulers(k_count);
+  std::vector<Rotation> rotations(k_count);
+
+  for (auto& euler : eulers) euler = RandomVector3() * 3.14159f;
+
+  Run("Rotation::set_euler", k_count, [&]() {
+    for (size_t i = 0; i < k_count; i++) rotations[i].set_euler(eulers[i]);
+    g_sink = (u32)rotations[0].get_matrix()[0][0];
+  });
+}
+
+// Components that are only used to populate the GameObjects of the benchmarks.
+template<int n>
+struct BenchComponent final : Component {
+  BenchComponent(GameObject* owner) : Component(owner) {}
+};
+
+struct BenchBounds final : Component {
+  BenchBounds(GameObject* owner, Box3 const& box) : Component(owner), box(box) {}
+
+  Box3 box;
+};
+
+static void BenchmarkComponents() {
+  constexpr size_t k_count = 10000;
+
+  // The component storage that GameObject used before component type IDs, for comparison.
+  std::vector<std::unordered_map<std::type_index, Component*>> component_maps(k_count);
+  std::vector<GameObject*> objects;
+
+  const auto add_component = [&](size_t i, auto* component) {
+    component_maps[i][std::type_index{typeid(*component)}] = component;
+  };
+
+  for (size_t i = 0; i < k_count; i++) {
+    auto object = new GameObject{};
+
+    add_component(i, &object->transform());
+    if (i % 2 == 0) add_component(i, object->add_component<BenchComponent<0>>());
+    if (i % 3 == 0) add_component(i, object->add_component<BenchComponent<1>>());
+    if (i % 5 == 0) add_component(i, object->add_component<BenchComponent<2>>());
+
+    objects.push_back(object);
+  }
+
+  Run("get_component (unordered_map)", k_count, [&]() {
+    u32 found = 0;
+
+    for (auto& components : component_maps) {
+      auto it = components.find(std::type_index{typeid(BenchComponent<1>)});
+      if (it != components.end() && it->second) found++;
+    }
+    g_sink = found;
+  });
+
+  Run("GameObject::get_component", k_count, [&]() {
+    u32 found = 0;
+
+    for (auto object : objects) {
+      if (object->get_component<BenchComponent<1>>()) found++;
+    }
+    g_sink = found;
+  });
+
+  for (auto object : objects) delete object;
+}
+
+static void BenchmarkSceneLifetime() {
+  constexpr size_t k_count = 200000;
+
+  std::vector<GameObject*> objects;
+
+  objects.reserve(k_count);
+
+  // Build and destroy a hierarchy, as when loading and unloading a level.
+  Run("GameObject create and destroy", k_count, [&]() {
+    objects.clear();
+    objects.push_back(new GameObject{"scene"});
+
+    for (size_t i = 1; i < k_count; i++) {
+      auto object = new GameObject{};
+
+      objects[g_rng() % objects.size()]->add_child(object);
+      objects.push_back(object);
+
+      if (i % 4 != 0) {
+        object->add_component<BenchBounds>(Box3{});
+      }
+    }
+
+    delete objects[0];
+    g_sink = (u32)TransformSystem::get().update();
+  });
+}
+
+/**
+ * A node of the plain pointer-chasing hierarchy that serves as the baseline for the TransformSystem:
+ * every node stores its own matrices and the world matrices are updated by a depth-first traversal.
+ */
+struct TransformNode {
+  Matrix4 local;
+  Matrix4 world;
+  std::vector<u32> children;
+};
+
+static void UpdateChildrenRecursive(std::vector<TransformNode>& nodes, u32 index) {
+  auto& node = nodes[index];
+
+  for (auto child : node.children) {
+    nodes[child].world = node.world * nodes[child].local;
+    UpdateChildrenRecursive(nodes, child);
+  }
+}
+
+static void BenchmarkTransforms() {
+  constexpr size_t k_count = 100000;
+
+  // Generate a random hierarchy, attaching each node to a previously created node.
+  auto scene = new GameObject{"scene"};
+  std::vector<GameObject*> objects{scene};
+  std::vector<TransformNode> nodes(k_count);
+
+  for (size_t i = 1; i < k_count; i++) {
+    auto object = new GameObject{};
+    auto& transform = object->transform();
+    auto parent = g_rng() % objects.size();
+
+    transform.position() = RandomVector3() * 10;
+    transform.rotation().set_quaternion(RandomQuaternion());
+
+    objects[parent]->add_child(object);
+    objects.push_back(object);
+    nodes[parent].children.push_back((u32)i);
+  }
+
+  auto& transform_system = TransformSystem::get();
+
+  transform_system.update();
+
+  for (size_t i = 0; i < k_count; i++) {
+    nodes[i].local = objects[i]->transform().local();
+  }
+
+  // Moving the root forces all world matrices to be recomputed.
+  Run("Recursive world matrix update", k_count, [&]() {
+    auto& root = nodes[0];
+
+    root.local[3][0] += 1;
+    root.world = root.local;
+    UpdateChildrenRecursive(nodes, 0);
+    g_sink = (u32)nodes.back().world[3][0];
+  });
+
+  // Measure how the update scales with the number of threads, including the calling thread.
+  ForEachThreadCount([&](u32 thread_count) {
+    auto job_system = JobSystem{thread_count - 1};
+    auto name = "TransformSystem::update (" + std::to_string(thread_count) + " threads)";
+
+    transform_system.set_job_system(&job_system);
+
+    Run(name.c_str(), k_count, [&]() {
+      scene->transform().position().X() += 1;
+      g_sink = (u32)transform_system.update();
+    });
+
+    transform_system.set_job_system(nullptr);
+  });
+
+  delete scene;
+  transform_system.update();
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    g_filter = argv[1];
+  }
+
+  BenchmarkRotations();
+  BenchmarkComponents();
+  BenchmarkSceneLifetime();
+  BenchmarkTransforms();
+
+  WriteJSON();
+  return 0;
+}
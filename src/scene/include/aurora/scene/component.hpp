@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <aurora/integer.hpp>
+#include <aurora/log.hpp>
+#include <aurora/pool_allocator.hpp>
 #include <aurora/utility.hpp>
+#include <atomic>
+#include <type_traits>
 
 namespace Aura {
 
@@ -17,6 +22,50 @@ namespace Aura {
     "AuroraScene: T must be a removable Aura::Component");
 
 struct GameObject;
+struct Component;
+
+/**
+ * The maximum number of distinct component types, which is limited by the size of the component mask of a GameObject.
+ */
+constexpr u32 k_max_component_types = 64;
+
+namespace detail {
+
+using ComponentDestroyFn = void (*)(Component*);
+
+// Destroys a component and returns its memory to the pool of its type, indexed by component type ID.
+inline ComponentDestroyFn g_component_destroy_fns[k_max_component_types];
+
+inline auto register_component_type(ComponentDestroyFn destroy) -> u32 {
+  static std::atomic<u32> next_id = 0;
+
+  auto id = next_id++;
+  Assert(id < k_max_component_types, "AuroraScene: too many component types, the limit is {}.", k_max_component_types);
+  g_component_destroy_fns[id] = destroy;
+  return id;
+}
+
+} // namespace Aura::detail
+
+/**
+ * Get the dense ID of a component type. IDs are assigned in the order in which the types are first used.
+ * Components are allocated from a {@link #PoolAllocator} per type, which is also registered here.
+ *
+ * @tparam T the component type
+ * @return the ID of the component type, which is less than k_max_component_types
+ */
+template<typename T>
+auto component_type_id() -> u32 {
+  AURA_ASSERT_IS_COMPONENT(T);
+
+  static const u32 id = detail::register_component_type([](Component* component) {
+    auto object = static_cast<T*>(component);
+
+    object->~T();
+    PoolAllocator<T>::Get().Release(object);
+  });
+  return id;
+}
 
 struct Component : NonCopyable, NonMovable {
   Component(GameObject* owner) : owner_(owner) {
@@ -1,71 +1,142 @@
-
 // Copyright (C) 2022 fleroviux. All rights reserved.
 
+#pragma once
+
 #include <aurora/math/matrix4.hpp>
 #include <aurora/scene/component.hpp>
 #include <aurora/scene/rotation.hpp>
+#include <aurora/scene/transform_system.hpp>
+#include <aurora/integer.hpp>
 
 namespace Aura {
 
 /**
- * TODO:
- * - Think about a better interface for matrix updated
+ * The position, rotation and scale of a GameObject relative to its parent.
+ *
+ * This is a handle to the data stored in the {@link #TransformSystem}.
+ * Accessing position(), rotation() or scale() for writing marks the local matrix as dirty.
+ * TransformSystem::update() then only recomputes the matrices that are out-of-date.
+ *
+ * The returned references are invalidated when transforms are created or when the system reorders its data.
  */
-
 struct Transform final : Component {
-  Transform(GameObject* owner) : Component(owner) {}
+  Transform(GameObject* owner)
+      : Component(owner)
+      , system_(&TransformSystem::get())
+      , id_(system_->create()) {
+  }
+
+ ~Transform() override {
+    system_->destroy(id_);
+  }
+
+  /**
+   * Get the id of this transform in the {@link #TransformSystem}, which stays the same for the lifetime of the transform.
+   */
+  auto id() const -> u32 {
+    return id_;
+  }
 
   auto position() -> Vector3& {
-    return position_;
+    state().local_dirty = true;
+    return system_->positions_[index()];
   }
 
   auto position() const -> Vector3 const& {
-    return position_;
+    return system_->positions_[index()];
   }
 
   auto rotation() -> Rotation& {
-    return rotation_;
+    state().local_dirty = true;
+    return system_->rotations_[index()];
   }
 
   auto rotation() const -> Rotation const& {
-    return rotation_;
+    return system_->rotations_[index()];
   }
 
   auto scale() -> Vector3& {
-    return scale_;
+    state().local_dirty = true;
+    return system_->scales_[index()];
   }
 
   auto scale() const -> Vector3 const& {
-    return scale_;
+    return system_->scales_[index()];
   }
 
   auto local() const -> Matrix4 const& {
-    return matrix_local_;
+    return system_->locals_[index()];
   }
 
   auto world() const -> Matrix4 const& {
-    return matrix_world_;
+    return system_->worlds_[index()];
+  }
+
+  /**
+   * Get a counter that is incremented whenever the world matrix changes.
+   * This allows caching data that is derived from the world matrix, for example world-space bounding boxes.
+   */
+  auto world_version() const -> u32 {
+    return system_->world_versions_[index()];
+  }
+
+  /**
+   * Get the structure of the world matrix, as determined by the last world matrix update.
+   * The matrix is rigid unless this transform or any of its ancestors has a non-uniform scale.
+   */
+  auto world_class() const -> MatrixClass {
+    return system_->world_classes_[index()];
+  }
+
+  /**
+   * Get the inverse of the world matrix, using the cheapest inversion algorithm for its class.
+   */
+  auto world_inverse() const -> Matrix4 {
+    return world().Inverse(world_class());
   }
 
   auto auto_update() -> bool& {
-    return auto_update_;
+    return state().auto_update;
   }
 
-  void update_local();
-  void update_world(bool update_children);
+  /**
+   * Check whether position(), rotation() or scale() may have been modified since the local matrix was last updated.
+   */
+  bool dirty() const {
+    return system_->states_[index()].local_dirty;
+  }
+
+  /**
+   * Force the world matrix to be recomputed on the next update.
+   */
+  void invalidate_world() {
+    state().world_dirty = true;
+  }
+
+  /**
+   * Attach this transform to the transform of the parent GameObject. This is called by GameObject::add_child().
+   *
+   * @param parent the parent transform or nullptr to make this transform a root
+   */
+  void set_parent(Transform const* parent) {
+    system_->set_parent(id_, parent ? parent->id_ : TransformSystem::k_invalid_id);
+  }
 
   static constexpr bool removable() {
     return false;
   }
 
 private:
-  Vector3 position_ {0, 0, 0};
-  Vector3 scale_ {1, 1, 1};
-  Rotation rotation_;
+  auto index() const -> u32 {
+    return system_->index_of(id_);
+  }
+
+  auto state() -> TransformSystem::State& {
+    return system_->states_[index()];
+  }
 
-  bool auto_update_ = true;
-  Matrix4 matrix_local_;
-  Matrix4 matrix_world_;
+  TransformSystem* system_;
+  u32 id_;
 };
 
 } // namespace Aura
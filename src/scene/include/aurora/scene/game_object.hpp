@@ -5,13 +5,15 @@
 
 #include <aurora/scene/component/transform.hpp>
 #include <aurora/scene/component.hpp>
+#include <aurora/scene/scene_listener.hpp>
 #include <aurora/log.hpp>
+#include <aurora/pool_allocator.hpp>
 #include <aurora/utility.hpp>
 #include <algorithm>
+#include <new>
 #include <string>
-#include <typeindex>
 #include <type_traits>
-#include <unordered_map>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -28,10 +30,32 @@ struct GameObject final : NonCopyable, NonMovable {
   }
 
  ~GameObject() {
-    for (auto child : children()) delete child;
-    for (auto pair : components_) delete pair.second;
+    SceneListener::notify_all([&](SceneListener& listener) { listener.on_destroyed(this); });
+
+    // Destroy the subtree iteratively, so that deep hierarchies cannot overflow the stack.
+    // The descendants are detached first, so that their destructors only have to destroy their components.
+    auto subtree = std::move(children_);
+
+    for (size_t i = 0; i < subtree.size(); i++) {
+      auto& children = subtree[i]->children_;
+
+      subtree.insert(subtree.end(), children.begin(), children.end());
+      children.clear();
+    }
+
+    // Destroy children before their parents, like the recursive destruction would.
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) delete *it;
+
+    destroy_components();
   }
 
+  /**
+   * GameObjects are allocated from a {@link #PoolAllocator}, so that creating and destroying
+   * large hierarchies does not go through the general-purpose heap for every object.
+   */
+  static auto operator new(size_t size) -> void*;
+  static void operator delete(void* object);
+
   bool has_parent() const {
     return parent() != nullptr;
   }
@@ -64,8 +88,23 @@ struct GameObject final : NonCopyable, NonMovable {
     return visible_;
   }
 
-  bool& visible() {
-    return visible_;
+  void set_visible(bool visible) {
+    if (visible_ != visible) {
+      visible_ = visible;
+      SceneListener::notify_all([&](SceneListener& listener) { listener.on_visibility_changed(this); });
+    }
+  }
+
+  /**
+   * Check whether this object and all of its ancestors are visible.
+   */
+  bool visible_in_hierarchy() const {
+    for (auto object = this; object; object = object->parent_) {
+      if (!object->visible_) {
+        return false;
+      }
+    }
+    return true;
   }
 
   void add_child(GameObject* child) {
@@ -78,28 +117,36 @@ struct GameObject final : NonCopyable, NonMovable {
 
     children_.push_back(child);
     child->parent_ = this;
+    child->transform().set_parent(transform_);
+    SceneListener::notify_all([&](SceneListener& listener) { listener.on_child_added(this, child); });
   }
 
   void remove_child(GameObject* child) {
     if (child->parent_ == this) {
       children_.erase(std::find(children_.begin(), children_.end(), child));
       child->parent_ = nullptr;
+      child->transform().set_parent(nullptr);
+      SceneListener::notify_all([&](SceneListener& listener) { listener.on_child_removed(this, child); });
     }
   }
 
   template<typename T>
   bool has_component() const {
-    return get_component<T>() != nullptr;
+    return (component_mask_ & (u64{1} << component_type_id<T>())) != 0;
   }
 
   template<typename T, typename... Args>
   auto add_component(Args&&... args) -> T* {
     AURA_ASSERT_IS_COMPONENT(T);
 
-    auto component = new T{this, args...};
+    auto id = component_type_id<T>();
     Assert(!has_component<T>(),
       "AuroraScene: duplicate component {} on object {}.", typeid(T).name(), get_name());
-    components_[std::type_index{typeid(T)}] = component;
+
+    auto component = new (PoolAllocator<T>::Get().Allocate()) T{this, args...};
+    components_.insert(components_.begin() + component_index(id), component);
+    component_mask_ |= u64{1} << id;
+    SceneListener::notify_all([&](SceneListener& listener) { listener.on_component_added(this, component); });
     return component;
   }
 
@@ -107,21 +154,35 @@ struct GameObject final : NonCopyable, NonMovable {
   void remove_component() {
     AURA_ASSERT_IS_REMOVABLE_COMPONENT(T);
 
-    auto it = components_.find(std::type_index{typeid(T)});
-    if (it != components_.end()) {
-      auto component = it->second;
+    if (has_component<T>()) {
+      auto id = component_type_id<T>();
+      auto it = components_.begin() + component_index(id);
+      auto component = *it;
+      SceneListener::notify_all([&](SceneListener& listener) { listener.on_component_removed(this, component); });
       components_.erase(it);
-      delete component;
+      component_mask_ &= ~(u64{1} << id);
+      detail::g_component_destroy_fns[id](component);
     }
   }
 
+  /**
+   * Notify the {@link #SceneListener}s that a property of a component changed, which affects
+   * how the component is represented in the scene. Called by components from their setters.
+   *
+   * @param component the component, which must belong to this object
+   */
+  void notify_component_changed(Component* component) {
+    SceneListener::notify_all([&](SceneListener& listener) { listener.on_component_changed(this, component); });
+  }
+
   template<typename T>
   auto get_component() -> T* {
     AURA_ASSERT_IS_COMPONENT(T);
-  
-    auto it = components_.find(std::type_index{typeid(T)});
-    if (it != components_.end()) {
-      return reinterpret_cast<T*>(it->second);
+
+    auto id = component_type_id<T>();
+
+    if (component_mask_ & (u64{1} << id)) {
+      return reinterpret_cast<T*>(components_[component_index(id)]);
     }
     return nullptr;
   }
@@ -136,12 +197,41 @@ private:
     transform_ = add_component<Transform>();
   }
 
+  void destroy_components() {
+    size_t index = 0;
+
+    for (u32 id = 0; index < components_.size(); id++) {
+      if (component_mask_ & (u64{1} << id)) {
+        detail::g_component_destroy_fns[id](components_[index++]);
+      }
+    }
+  }
+
+  /**
+   * Get the index of a component in the components array, which is sorted by component type ID.
+   * This is the number of components on this object with a lower type ID.
+   */
+  auto component_index(u32 id) const -> size_t {
+    return popcount(component_mask_ & ((u64{1} << id) - 1));
+  }
+
   GameObject* parent_ = nullptr;
   std::vector<GameObject*> children_;
   std::string name_ = "GameObject";
   bool visible_ = true;
-  std::unordered_map<std::type_index, Component*> components_;
+  u64 component_mask_ = 0;
+  std::vector<Component*> components_;
   Transform* transform_;
 };
 
+inline auto GameObject::operator new(size_t size) -> void* {
+  Assert(size == sizeof(GameObject), "AuroraScene: unexpected GameObject allocation size {}.", size);
+
+  return PoolAllocator<GameObject>::Get().Allocate();
+}
+
+inline void GameObject::operator delete(void* object) {
+  PoolAllocator<GameObject>::Get().Release(object);
+}
+
 } // namespace Aura
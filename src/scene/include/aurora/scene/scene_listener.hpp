@@ -0,0 +1,88 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/utility.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace Aura {
+
+struct Component;
+struct GameObject;
+struct SceneListener;
+
+namespace detail {
+
+inline std::vector<SceneListener*> g_scene_listeners;
+
+} // namespace Aura::detail
+
+/**
+ * Receives notifications about structural changes to GameObjects, so that systems can maintain
+ * derived data (for example a list of renderables) incrementally instead of walking the scene every frame.
+ *
+ * A listener receives the notifications of all GameObjects from construction until destruction.
+ * Notifications are delivered synchronously on the thread that made the change.
+ * Listeners must not be created or destroyed from within a notification.
+ */
+struct SceneListener : NonCopyable, NonMovable {
+  SceneListener() {
+    detail::g_scene_listeners.push_back(this);
+  }
+
+  virtual ~SceneListener() {
+    auto& listeners = detail::g_scene_listeners;
+
+    listeners.erase(std::find(listeners.begin(), listeners.end(), this));
+  }
+
+  /**
+   * Called after a child was attached to a parent.
+   */
+  virtual void on_child_added(GameObject* /*parent*/, GameObject* /*child*/) {}
+
+  /**
+   * Called after a child was detached from its parent.
+   */
+  virtual void on_child_removed(GameObject* /*parent*/, GameObject* /*child*/) {}
+
+  /**
+   * Called after a component was added to an object.
+   */
+  virtual void on_component_added(GameObject* /*object*/, Component* /*component*/) {}
+
+  /**
+   * Called before a component is removed from an object and destroyed.
+   */
+  virtual void on_component_removed(GameObject* /*object*/, Component* /*component*/) {}
+
+  /**
+   * Called after a property of a component changed that affects how it is represented in the scene,
+   * for example the geometry or material of a mesh. See GameObject::notify_component_changed().
+   */
+  virtual void on_component_changed(GameObject* /*object*/, Component* /*component*/) {}
+
+  /**
+   * Called after the visibility of an object changed.
+   */
+  virtual void on_visibility_changed(GameObject* /*object*/) {}
+
+  /**
+   * Called before an object and its components are destroyed. This is not preceded by on_child_removed() or
+   * on_component_removed(). When a subtree is destroyed, it is called for every object in the subtree.
+   */
+  virtual void on_destroyed(GameObject* /*object*/) {}
+
+  /**
+   * Deliver a notification to all listeners.
+   *
+   * @param notify a function that is called with each listener
+   */
+  template<typename Function>
+  static void notify_all(Function&& notify) {
+    for (auto listener : detail::g_scene_listeners) notify(*listener);
+  }
+};
+
+} // namespace Aura
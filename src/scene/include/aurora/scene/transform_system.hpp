@@ -0,0 +1,155 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#pragma once
+
+#include <aurora/math/matrix4.hpp>
+#include <aurora/scene/rotation.hpp>
+#include <aurora/integer.hpp>
+#include <aurora/utility.hpp>
+#include <vector>
+
+namespace Aura {
+
+struct JobSystem;
+
+/**
+ * Stores the data of all {@link #Transform} components in contiguous arrays, which are sorted by hierarchy depth.
+ * Because parents always precede their children, all world matrices can be updated in one linear pass
+ * without following pointers through the GameObject hierarchy.
+ *
+ * Transforms are identified by stable ids, which are mapped to their current index in the arrays.
+ * The arrays are reordered lazily by update() after transforms were created, destroyed or reparented.
+ * This moves the data of the transforms, so references obtained through a {@link #Transform} handle
+ * must not be held across calls to create() or update().
+ *
+ * Large hierarchies are updated one depth level at a time, with the transforms of a level split into batches
+ * that are processed in parallel by a {@link #JobSystem}. The results are identical to the serial update.
+ */
+struct TransformSystem final : NonCopyable, NonMovable {
+  static constexpr u32 k_invalid_id = ~0u;
+
+  /**
+   * Get the transform system that holds the transforms of all GameObjects.
+   */
+  static auto get() -> TransformSystem&;
+
+  /**
+   * Create a new transform without a parent and with an identity local matrix.
+   * @return the id of the transform
+   */
+  auto create() -> u32;
+
+  /**
+   * Destroy a transform. The id may be reused after the next update().
+   *
+   * @param id the id of the transform
+   */
+  void destroy(u32 id);
+
+  /**
+   * Change the parent of a transform. This forces its world matrix to be recomputed.
+   *
+   * @param id        the id of the transform
+   * @param parent_id the id of the new parent transform or `k_invalid_id` to make it a root
+   */
+  void set_parent(u32 id, u32 parent_id);
+
+  /**
+   * Recompute the local matrices of all transforms that are dirty and
+   * the world matrices of all transforms whose local matrix or parent world matrix changed.
+   *
+   * @return the number of world matrices that were recomputed
+   */
+  auto update() -> size_t;
+
+  /**
+   * Get the ids of the transforms whose world matrix changed during the last update(), in depth order.
+   * This allows systems that cache data derived from world matrices to only refresh what changed.
+   */
+  auto changed_ids() const -> std::vector<u32> const& {
+    return changed_ids_;
+  }
+
+  /**
+   * Get the number of calls to update(). A system that consumes changed_ids() can compare this
+   * against the count it last saw, to detect whether it missed the changes of an update.
+   */
+  auto update_count() const -> u64 {
+    return update_count_;
+  }
+
+  /**
+   * Set the job system that update() uses to process large hierarchies in parallel.
+   * Defaults to the shared job system, which is only created once it is needed.
+   *
+   * @param job_system the job system or nullptr to always update serially
+   */
+  void set_job_system(JobSystem* job_system) {
+    job_system_ = job_system;
+    use_shared_job_system_ = false;
+  }
+
+  /**
+   * Get the number of transforms, including transforms that were destroyed since the last update().
+   */
+  auto size() const -> size_t {
+    return ids_.size();
+  }
+
+private:
+  friend struct Transform;
+
+  struct State {
+    bool alive = true;
+    bool auto_update = true;
+    bool local_dirty = true;
+    bool world_dirty = true;
+  };
+
+  auto index_of(u32 id) const -> u32 {
+    return index_of_[id];
+  }
+
+  // Hierarchies below this size are always updated serially, the cost of synchronization would outweigh the gain.
+  static constexpr size_t k_parallel_threshold = 16384;
+  static constexpr size_t k_batch_size = 1024;
+
+  auto update_range(u32 begin, u32 end, std::vector<u32>& changed_ids) -> size_t;
+  void update_local(u32 index);
+  bool update_world(u32 index, u32 parent);
+  void sort();
+
+  // The following arrays are indexed by id.
+  std::vector<u32> index_of_;
+  std::vector<u32> free_ids_;
+  std::vector<u32> destroyed_ids_;
+
+  // The following arrays are indexed by the position in the depth-sorted order.
+  std::vector<u32> ids_;
+  std::vector<u32> parent_ids_;
+  std::vector<u32> parents_;
+  std::vector<State> states_;
+  std::vector<Vector3> positions_;
+  std::vector<Vector3> scales_;
+  std::vector<Rotation> rotations_;
+  std::vector<Matrix4> locals_;
+  std::vector<Matrix4> worlds_;
+  std::vector<MatrixClass> local_classes_;
+  std::vector<MatrixClass> world_classes_;
+  std::vector<u32> world_versions_;
+  std::vector<u8> world_changed_;
+
+  // Index of the first transform of each depth level. The last level ends at size().
+  std::vector<u32> level_offsets_;
+
+  bool order_dirty_ = false;
+
+  std::vector<u32> changed_ids_;
+  std::vector<std::vector<u32>> batch_changed_ids_;
+  u64 update_count_ = 0;
+
+  JobSystem* job_system_ = nullptr;
+  bool use_shared_job_system_ = true;
+};
+
+} // namespace Aura
@@ -0,0 +1,319 @@
+// Copyright (C) 2022 fleroviux. All rights reserved.
+
+#include <aurora/scene/transform_system.hpp>
+#include <aurora/job_system.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace Aura {
+
+template<typename T>
+static void Permute(std::vector<T>& array, std::vector<u32> const& order) {
+  std::vector<T> permuted;
+
+  permuted.reserve(order.size());
+
+  for (auto index : order) {
+    permuted.push_back(array[index]);
+  }
+
+  array = std::move(permuted);
+}
+
+auto TransformSystem::get() -> TransformSystem& {
+  // Never destroyed, so that GameObjects with static storage duration may safely outlive it.
+  static auto system = new TransformSystem{};
+
+  return *system;
+}
+
+auto TransformSystem::create() -> u32 {
+  u32 id;
+  u32 index = (u32)ids_.size();
+
+  if (free_ids_.empty()) {
+    id = (u32)index_of_.size();
+    index_of_.push_back(index);
+  } else {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+    index_of_[id] = index;
+  }
+
+  ids_.push_back(id);
+  parent_ids_.push_back(k_invalid_id);
+  parents_.push_back(k_invalid_id);
+  states_.emplace_back();
+  positions_.push_back({0, 0, 0});
+  scales_.push_back({1, 1, 1});
+  rotations_.emplace_back();
+  locals_.emplace_back();
+  worlds_.emplace_back();
+  local_classes_.push_back(MatrixClass::Rigid);
+  world_classes_.push_back(MatrixClass::Rigid);
+  world_versions_.push_back(0);
+  world_changed_.push_back(0);
+
+  // A new transform is a root and is appended after all other transforms. This keeps the parent-before-child order,
+  // but a root must precede all non-roots for the arrays to be sorted by depth.
+  if (index > 0 && parent_ids_[index - 1] != k_invalid_id) {
+    order_dirty_ = true;
+  }
+
+  if (level_offsets_.empty()) {
+    level_offsets_.push_back(0);
+  }
+
+  return id;
+}
+
+void TransformSystem::destroy(u32 id) {
+  states_[index_of(id)].alive = false;
+  destroyed_ids_.push_back(id);
+  order_dirty_ = true;
+}
+
+void TransformSystem::set_parent(u32 id, u32 parent_id) {
+  auto index = index_of(id);
+
+  if (parent_ids_[index] != parent_id) {
+    parent_ids_[index] = parent_id;
+    states_[index].world_dirty = true;
+    order_dirty_ = true;
+  }
+}
+
+auto TransformSystem::update() -> size_t {
+  if (order_dirty_) {
+    sort();
+  }
+
+  auto count = (u32)ids_.size();
+
+  changed_ids_.clear();
+  update_count_++;
+
+  if (count < k_parallel_threshold) {
+    return update_range(0, count, changed_ids_);
+  }
+
+  auto job_system = use_shared_job_system_ ? &JobSystem::Get() : job_system_;
+
+  if (!job_system || job_system->WorkerCount() == 0) {
+    return update_range(0, count, changed_ids_);
+  }
+
+  size_t updated = 0;
+  std::vector<size_t> batch_updated;
+
+  // A level only depends on the world matrices of the previous level, so the transforms within a level
+  // can be updated in any order. Each transform is still updated by exactly the same code as in the serial path.
+  for (size_t level = 0; level < level_offsets_.size(); level++) {
+    auto begin = level_offsets_[level];
+    auto end = level + 1 < level_offsets_.size() ? level_offsets_[level + 1] : count;
+    auto batch_count = (end - begin + k_batch_size - 1) / k_batch_size;
+
+    batch_updated.assign(batch_count, 0);
+
+    if (batch_changed_ids_.size() < batch_count) {
+      batch_changed_ids_.resize(batch_count);
+    }
+
+    job_system->ParallelFor(begin, end, k_batch_size, [&](size_t batch_begin, size_t batch_end) {
+      auto batch = (batch_begin - begin) / k_batch_size;
+
+      batch_changed_ids_[batch].clear();
+      batch_updated[batch] = update_range((u32)batch_begin, (u32)batch_end, batch_changed_ids_[batch]);
+    });
+
+    for (auto batch_result : batch_updated) updated += batch_result;
+
+    // Concatenate the batches in order, so that the result matches the serial update.
+    for (size_t batch = 0; batch < batch_count; batch++) {
+      auto& batch_changed_ids = batch_changed_ids_[batch];
+
+      changed_ids_.insert(changed_ids_.end(), batch_changed_ids.begin(), batch_changed_ids.end());
+    }
+  }
+
+  return updated;
+}
+
+auto TransformSystem::update_range(u32 begin, u32 end, std::vector<u32>& changed_ids) -> size_t {
+  size_t updated = 0;
+
+  for (u32 index = begin; index < end; index++) {
+    auto& state = states_[index];
+    auto parent = parents_[index];
+
+    if (state.local_dirty && state.auto_update) {
+      update_local(index);
+    }
+
+    if (state.world_dirty || (parent != k_invalid_id && world_changed_[parent])) {
+      world_changed_[index] = update_world(index, parent);
+      updated++;
+
+      if (world_changed_[index]) {
+        changed_ids.push_back(ids_[index]);
+      }
+    } else {
+      world_changed_[index] = 0;
+    }
+  }
+
+  return updated;
+}
+
+void TransformSystem::update_local(u32 index) {
+  auto& local = locals_[index];
+  auto& scale = scales_[index];
+
+  local = rotations_[index].get_matrix();
+
+  local.X() *= scale.X();
+  local.Y() *= scale.Y();
+  local.Z() *= scale.Z();
+  local.W()  = Vector4{positions_[index], 1.0};
+
+  if (scale.X() == scale.Y() && scale.Y() == scale.Z()) {
+    local_classes_[index] = MatrixClass::Rigid;
+  } else {
+    local_classes_[index] = MatrixClass::Affine;
+  }
+
+  states_[index].local_dirty = false;
+  states_[index].world_dirty = true;
+}
+
+bool TransformSystem::update_world(u32 index, u32 parent) {
+  auto& world = worlds_[index];
+  auto world_old = world;
+  auto world_class_old = world_classes_[index];
+
+  if (parent != k_invalid_id) {
+    world = worlds_[parent] * locals_[index];
+
+    if (world_classes_[parent] == MatrixClass::Rigid) {
+      world_classes_[index] = local_classes_[index];
+    } else {
+      world_classes_[index] = MatrixClass::Affine;
+    }
+  } else {
+    world = locals_[index];
+    world_classes_[index] = local_classes_[index];
+  }
+
+  states_[index].world_dirty = false;
+
+  if (std::memcmp(&world, &world_old, sizeof(Matrix4)) != 0) {
+    world_versions_[index]++;
+    return true;
+  }
+
+  return world_classes_[index] != world_class_old;
+}
+
+void TransformSystem::sort() {
+  auto count = (u32)ids_.size();
+
+  // Transforms whose parent was destroyed become roots.
+  for (u32 index = 0; index < count; index++) {
+    auto parent_id = parent_ids_[index];
+
+    if (parent_id != k_invalid_id && !states_[index_of(parent_id)].alive) {
+      parent_ids_[index] = k_invalid_id;
+      states_[index].world_dirty = true;
+    }
+  }
+
+  // Determine the depth of each transform, memoizing the depths of the ancestors along the way.
+  std::vector<u32> depths(count, k_invalid_id);
+  std::vector<u32> path;
+  u32 max_depth = 0;
+
+  for (u32 index = 0; index < count; index++) {
+    auto ancestor = index;
+
+    while (depths[ancestor] == k_invalid_id) {
+      auto parent_id = parent_ids_[ancestor];
+
+      if (parent_id == k_invalid_id) {
+        depths[ancestor] = 0;
+        break;
+      }
+
+      path.push_back(ancestor);
+      ancestor = index_of(parent_id);
+    }
+
+    auto depth = depths[ancestor];
+
+    while (!path.empty()) {
+      depths[path.back()] = ++depth;
+      path.pop_back();
+    }
+
+    max_depth = std::max(max_depth, depths[index]);
+  }
+
+  // Stable counting sort by depth, dropping destroyed transforms.
+  std::vector<u32> offsets(max_depth + 2, 0);
+
+  for (u32 index = 0; index < count; index++) {
+    if (states_[index].alive) {
+      offsets[depths[index] + 1]++;
+    }
+  }
+
+  for (u32 depth = 1; depth < offsets.size(); depth++) {
+    offsets[depth] += offsets[depth - 1];
+  }
+
+  std::vector<u32> order(offsets.back());
+
+  level_offsets_.assign(offsets.begin(), offsets.end() - 1);
+
+  for (u32 index = 0; index < count; index++) {
+    if (states_[index].alive) {
+      order[offsets[depths[index]]++] = index;
+    }
+  }
+
+  Permute(ids_, order);
+  Permute(parent_ids_, order);
+  Permute(states_, order);
+  Permute(positions_, order);
+  Permute(scales_, order);
+  Permute(rotations_, order);
+  Permute(locals_, order);
+  Permute(worlds_, order);
+  Permute(local_classes_, order);
+  Permute(world_classes_, order);
+  Permute(world_versions_, order);
+  Permute(world_changed_, order);
+
+  for (auto id : destroyed_ids_) {
+    index_of_[id] = k_invalid_id;
+    free_ids_.push_back(id);
+  }
+  destroyed_ids_.clear();
+
+  count = (u32)ids_.size();
+
+  for (u32 index = 0; index < count; index++) {
+    index_of_[ids_[index]] = index;
+  }
+
+  parents_.resize(count);
+
+  for (u32 index = 0; index < count; index++) {
+    auto parent_id = parent_ids_[index];
+
+    parents_[index] = parent_id == k_invalid_id ? k_invalid_id : index_of(parent_id);
+  }
+
+  order_dirty_ = false;
+}
+
+} // namespace Aura